@@ -11,19 +11,67 @@
 #endif
 
 #include <avr/io.h>
-#include <util/delay.h>
+#include <avr/pgmspace.h>
 #include "SoftwareSPI.h"
 
 // --- Pin Definitions (From your uploaded file) ---
 #define ADF_PIN_LE      PB0
 #define ADF_PIN_DATA    PB1
 #define ADF_PIN_CLK     PB2
+#define ADF_PIN_LD      PB4     // LD (or MUXOUT) from the module, input
+
+// Bit-parallel bus (soft_spi_bus). Lane 0 is the board's own ADF4351; each
+// extra lane needs a DATA and an LE pin on PORTB, defined by the build.
+// Lanes may give the same LE pin to latch as one group.
+#ifndef SOFT_SPI_LANES
+#define SOFT_SPI_LANES  1
+#endif
+#define SOFT_SPI_LANE0_DATA ADF_PIN_DATA
+#define SOFT_SPI_LANE0_LE   ADF_PIN_LE
+#if SOFT_SPI_LANES > 4
+#error "soft_spi_bus supports up to 4 lanes"
+#endif
+#if SOFT_SPI_LANES > 1 && !(defined(SOFT_SPI_LANE1_DATA) && defined(SOFT_SPI_LANE1_LE))
+#error "SOFT_SPI_LANES > 1 needs SOFT_SPI_LANE1_DATA and SOFT_SPI_LANE1_LE"
+#endif
+#if SOFT_SPI_LANES > 2 && !(defined(SOFT_SPI_LANE2_DATA) && defined(SOFT_SPI_LANE2_LE))
+#error "SOFT_SPI_LANES > 2 needs SOFT_SPI_LANE2_DATA and SOFT_SPI_LANE2_LE"
+#endif
+#if SOFT_SPI_LANES > 3 && !(defined(SOFT_SPI_LANE3_DATA) && defined(SOFT_SPI_LANE3_LE))
+#error "SOFT_SPI_LANES > 3 needs SOFT_SPI_LANE3_DATA and SOFT_SPI_LANE3_LE"
+#endif
 
 // Mapped to internal names
 #define SOFT_SPI_CS_PIN   ADF_PIN_LE
 #define SOFT_SPI_MOSI_PIN ADF_PIN_DATA
 #define SOFT_SPI_SCK_PIN  ADF_PIN_CLK
 
+// --- ADF4351 Serial Timing (datasheet minimums, ns) ---
+#define ADF_T_CLK_HIGH_NS   25      // t4
+#define ADF_T_CLK_LOW_NS    25      // t5
+#define ADF_T_LE_NS         20      // t1 / t7, LE setup and pulse width
+
+// Cycles each phase must last at F_CPU, rounded up. One OUT is one cycle,
+// so only the part above one cycle needs padding.
+#define SOFT_SPI_NS_TO_CYCLES(ns) ((((ns) * (F_CPU / 1000UL)) + 999999UL) / 1000000UL)
+#define SOFT_SPI_CLK_CYCLES \
+    (SOFT_SPI_NS_TO_CYCLES(ADF_T_CLK_HIGH_NS) > SOFT_SPI_NS_TO_CYCLES(ADF_T_CLK_LOW_NS) ? \
+     SOFT_SPI_NS_TO_CYCLES(ADF_T_CLK_HIGH_NS) : SOFT_SPI_NS_TO_CYCLES(ADF_T_CLK_LOW_NS))
+#define SOFT_SPI_LE_CYCLES  SOFT_SPI_NS_TO_CYCLES(ADF_T_LE_NS)
+
+#define SOFT_SPI_DELAY(cycles) \
+    do { if ((cycles) > 1) __builtin_avr_delay_cycles((cycles) - 1); } while (0)
+
+// One bit: set DATA with CLK low, then raise CLK
+#define SOFT_SPI_BIT(b, m, d0, d1, d0c, d1c)                                        \
+    do {                                                                            \
+        if ((b) & (m)) { PORTB = (d1); SOFT_SPI_DELAY(SOFT_SPI_CLK_CYCLES); PORTB = (d1c); } \
+        else           { PORTB = (d0); SOFT_SPI_DELAY(SOFT_SPI_CLK_CYCLES); PORTB = (d0c); } \
+        SOFT_SPI_DELAY(SOFT_SPI_CLK_CYCLES);                                        \
+    } while (0)
+
+static void soft_spi_bus_init(void);
+
 void soft_spi_init(void) {
     // 1. Set MOSI, SCK, CS as Outputs
     // Use |= to preserve other pin settings on PORTB (like LCD)
@@ -35,6 +83,13 @@ void soft_spi_init(void) {
     
     // SCK starts LOW (Mode 0)
     PORTB &= ~(1 << SOFT_SPI_SCK_PIN);
+
+    // 3. Lock detect input; the pull-up reads as locked when LD is not wired
+    DDRB &= ~(1 << ADF_PIN_LD);
+    PORTB |= (1 << ADF_PIN_LD);
+
+    // 4. Extra bus lanes, if the build has any
+    if (SOFT_SPI_LANES > 1) soft_spi_bus_init();
 }
 
 void soft_spi_chip_enable(void) {
@@ -47,24 +102,158 @@ void soft_spi_chip_disable(void) {
     PORTB |= (1 << SOFT_SPI_CS_PIN);
 }
 
+// Shift one byte MSB first. Every edge is a single store of a precomputed
+// PORTB value: d0/d1 = CLK low with DATA 0/1, d0c/d1c = same with CLK high.
+static inline __attribute__((always_inline))
+void soft_spi_shift8(uint8_t b, uint8_t d0, uint8_t d1, uint8_t d0c, uint8_t d1c) {
+    SOFT_SPI_BIT(b, 0x80, d0, d1, d0c, d1c);
+    SOFT_SPI_BIT(b, 0x40, d0, d1, d0c, d1c);
+    SOFT_SPI_BIT(b, 0x20, d0, d1, d0c, d1c);
+    SOFT_SPI_BIT(b, 0x10, d0, d1, d0c, d1c);
+    SOFT_SPI_BIT(b, 0x08, d0, d1, d0c, d1c);
+    SOFT_SPI_BIT(b, 0x04, d0, d1, d0c, d1c);
+    SOFT_SPI_BIT(b, 0x02, d0, d1, d0c, d1c);
+    SOFT_SPI_BIT(b, 0x01, d0, d1, d0c, d1c);
+}
+
 void soft_spi_transfer(uint8_t data) {
-    // Bit-bang 8 bits, MSB first
-    for (int i = 0; i < 8; i++) {
-        
-        // 1. Set MOSI Data
-        if (data & 0x80) {
-            PORTB |= (1 << SOFT_SPI_MOSI_PIN);
-        } else {
-            PORTB &= ~(1 << SOFT_SPI_MOSI_PIN);
-        }
+    // Keep the LE and non-SPI PORTB bits as they are
+    uint8_t d0  = PORTB & ~((1 << SOFT_SPI_MOSI_PIN) | (1 << SOFT_SPI_SCK_PIN));
+    uint8_t d1  = d0 | (1 << SOFT_SPI_MOSI_PIN);
+
+    soft_spi_shift8(data, d0, d1, d0 | (1 << SOFT_SPI_SCK_PIN), d1 | (1 << SOFT_SPI_SCK_PIN));
+    PORTB = d0;
+}
 
-        // 2. Pulse SCK
-        _delay_us(2); 
-        PORTB |= (1 << SOFT_SPI_SCK_PIN); // High
-        _delay_us(2);
-        PORTB &= ~(1 << SOFT_SPI_SCK_PIN); // Low
+// Fast path: LE low, 32 bits MSB first, LE high to latch.
+// About 6 cycles per bit (sbrs/rjmp + two OUTs), ~200 cycles per word
+// including setup, i.e. ~18 us at 11.0592 MHz against ~170 us for four
+// soft_spi_transfer() calls with the old 2 us half-periods.
+// PORTB is sampled once, so no ISR may write PORTB during a word.
+void soft_spi_write32(uint32_t value) {
+    uint8_t d0  = PORTB & ~((1 << SOFT_SPI_MOSI_PIN) | (1 << SOFT_SPI_SCK_PIN) | (1 << SOFT_SPI_CS_PIN));
+    uint8_t d1  = d0 | (1 << SOFT_SPI_MOSI_PIN);
+    uint8_t d0c = d0 | (1 << SOFT_SPI_SCK_PIN);
+    uint8_t d1c = d1 | (1 << SOFT_SPI_SCK_PIN);
 
-        // 3. Shift Data
-        data <<= 1;
+    PORTB = d0;                                         // LE low
+    SOFT_SPI_DELAY(SOFT_SPI_LE_CYCLES);
+    soft_spi_shift8((uint8_t)(value >> 24), d0, d1, d0c, d1c);
+    soft_spi_shift8((uint8_t)(value >> 16), d0, d1, d0c, d1c);
+    soft_spi_shift8((uint8_t)(value >> 8),  d0, d1, d0c, d1c);
+    soft_spi_shift8((uint8_t)(value),       d0, d1, d0c, d1c);
+    PORTB = d0;                                         // CLK low
+    SOFT_SPI_DELAY(SOFT_SPI_LE_CYCLES);
+    PORTB = d0 | (1 << SOFT_SPI_CS_PIN);                // LE high latches
+}
+
+uint8_t soft_spi_lock_detect(void) {
+    return (PINB >> ADF_PIN_LD) & 1;
+}
+
+// --- Bit-parallel bus ---
+static const uint8_t soft_spi_lane_data[SOFT_SPI_LANES] PROGMEM = {
+    (1 << SOFT_SPI_LANE0_DATA),
+#if SOFT_SPI_LANES > 1
+    (1 << SOFT_SPI_LANE1_DATA),
+#endif
+#if SOFT_SPI_LANES > 2
+    (1 << SOFT_SPI_LANE2_DATA),
+#endif
+#if SOFT_SPI_LANES > 3
+    (1 << SOFT_SPI_LANE3_DATA),
+#endif
+};
+
+static const uint8_t soft_spi_lane_le[SOFT_SPI_LANES] PROGMEM = {
+    (1 << SOFT_SPI_LANE0_LE),
+#if SOFT_SPI_LANES > 1
+    (1 << SOFT_SPI_LANE1_LE),
+#endif
+#if SOFT_SPI_LANES > 2
+    (1 << SOFT_SPI_LANE2_LE),
+#endif
+#if SOFT_SPI_LANES > 3
+    (1 << SOFT_SPI_LANE3_LE),
+#endif
+};
+
+static void soft_spi_bus_init(void) {
+    uint8_t i;
+
+    // 1. Every lane's DATA and LE as outputs, LE high (inactive)
+    for (i = 0; i < SOFT_SPI_LANES; i++) {
+        DDRB |= pgm_read_byte(&soft_spi_lane_data[i]) | pgm_read_byte(&soft_spi_lane_le[i]);
+        PORTB |= pgm_read_byte(&soft_spi_lane_le[i]);
     }
-}
\ No newline at end of file
+    DDRB |= (1 << SOFT_SPI_SCK_PIN);
+    PORTB &= ~(1 << SOFT_SPI_SCK_PIN);
+}
+
+// Lanes whose LE pin is shared with any lane in the mask
+uint8_t soft_spi_bus_le_group(uint8_t lane_mask) {
+    uint8_t le = 0, group = 0, i;
+
+    for (i = 0; i < SOFT_SPI_LANES; i++)
+        if (lane_mask & (1 << i)) le |= pgm_read_byte(&soft_spi_lane_le[i]);
+    for (i = 0; i < SOFT_SPI_LANES; i++)
+        if (le & pgm_read_byte(&soft_spi_lane_le[i])) group |= (1 << i);
+    return group;
+}
+
+// Bit-sliced write: the PORTB value for each of the 32 clocks is built
+// first, so the shift itself is two stores per bit whatever the lane
+// count, the same pace as soft_spi_write32() for one device.
+void soft_spi_bus_write32(const uint32_t *words, uint8_t lane_mask) {
+    uint8_t slice[32];
+    uint8_t data = 0, le = 0, base, i, k;
+
+    for (i = 0; i < SOFT_SPI_LANES; i++) {
+        if (!(lane_mask & (1 << i))) continue;
+        data |= pgm_read_byte(&soft_spi_lane_data[i]);
+        le |= pgm_read_byte(&soft_spi_lane_le[i]);
+    }
+    base = PORTB & ~(data | le | (1 << SOFT_SPI_SCK_PIN));
+
+    // 1. Transpose: slice[k] carries bit 31-k of every lane on its DATA pin
+    for (k = 0; k < 32; k++) slice[k] = base;
+    for (i = 0; i < SOFT_SPI_LANES; i++) {
+        uint32_t w;
+        uint8_t  pin;
+        if (!(lane_mask & (1 << i))) continue;
+        w = words[i];                           // Lanes outside the mask may be unset
+        pin = pgm_read_byte(&soft_spi_lane_data[i]);
+        for (k = 0; k < 32; k++) {
+            if (w & 0x80000000UL) slice[k] |= pin;
+            w <<= 1;
+        }
+    }
+
+    // 2. Shift: LE low on the selected lanes, 32 clocks, one latch edge
+    PORTB = base;
+    SOFT_SPI_DELAY(SOFT_SPI_LE_CYCLES);
+    for (k = 0; k < 32; k++) {
+        PORTB = slice[k];
+        SOFT_SPI_DELAY(SOFT_SPI_CLK_CYCLES);
+        PORTB = slice[k] | (1 << SOFT_SPI_SCK_PIN);
+        SOFT_SPI_DELAY(SOFT_SPI_CLK_CYCLES);
+    }
+    PORTB = base;
+    SOFT_SPI_DELAY(SOFT_SPI_LE_CYCLES);
+    PORTB = base | le;
+}
+
+const spi_bus_t soft_spi_bus = {
+    SOFT_SPI_LANES,
+    soft_spi_bus_write32,
+    soft_spi_bus_le_group
+};
+
+const spi_transport_t soft_spi_transport = {
+    soft_spi_init,
+    soft_spi_chip_enable,
+    soft_spi_transfer,
+    soft_spi_chip_disable,
+    soft_spi_write32,
+    soft_spi_lock_detect
+};
\ No newline at end of file
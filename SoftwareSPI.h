@@ -11,10 +11,21 @@
 
 #include <avr/io.h>
 #include <stdint.h>
+#include "spi_transport.h"
 
 void soft_spi_init(void);
 void soft_spi_transfer(uint8_t data);
 void soft_spi_chip_enable(void);
 void soft_spi_chip_disable(void);
+void soft_spi_write32(uint32_t value);
+uint8_t soft_spi_lock_detect(void);
+void soft_spi_bus_write32(const uint32_t *words, uint8_t lane_mask);
+uint8_t soft_spi_bus_le_group(uint8_t lane_mask);
+
+// Bit-bang backend for the ADF4351 driver (see ADF4351_SetTransport)
+extern const spi_transport_t soft_spi_transport;
+
+// Bit-parallel backend for ADF4351_CommitGroup(), SOFT_SPI_LANES lanes
+extern const spi_bus_t soft_spi_bus;
 
 #endif /* SOFTWARESPI_H_ */
\ No newline at end of file
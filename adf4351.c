@@ -5,37 +5,35 @@
  * @date     07 January 2026
  */
 
+#include <stddef.h>
 #include "adf4351.h"
-#include "SoftwareSPI.h"
-#include <math.h>
-
-
-// Gathered from the ADF435x software from Analog Devices: https://www.analog.com/en/resources/evaluation-hardware-and-software/evaluation-boards-kits/eval-adf4351.html#eb-relatedsoftware
-#define R0_TEST 0x00418008	// 0000 0000 0100 0001 1000 0000 0000 1000	 ALL MSB FIRST TX
-#define R1_TEST 0x08008029	// 0000 1000 0000 0000 1000 0000 0010 1001
-#define R2_TEST 0x00004E42	// 0000 0000 0000 0000 0100 1110 0100 0010		
-#define R3_TEST 0x000004B3	// 0000 0000 0000 0000 0000 0100 1011 0011
-#define R4_TEST 0x00BC803C	// 0000 0000 1011 1100 1000 0000 0011 1100
-#define R5_TEST 0x00580005	// 0000 0000 0101 1000 0000 0000 0000 0101
-
-
-// Global Shadow Registers
-ADF4351_Reg0_t ADF4351_Reg0;
-ADF4351_Reg1_t ADF4351_Reg1;
-ADF4351_Reg2_t ADF4351_Reg2;
-ADF4351_Reg3_t ADF4351_Reg3;
-ADF4351_Reg4_t ADF4351_Reg4;
-ADF4351_Reg5_t ADF4351_Reg5;
-
-// Private Helper: Select Output Divider
-static ADF4351_RFDIV_t ADF4351_Select_Output_Divider(double RFoutFrequency)
-{
-    if (RFoutFrequency >= 2200000000.0) return ADF4351_RFDIV_1;
-    if (RFoutFrequency >= 1100000000.0)  return ADF4351_RFDIV_2;
-    if (RFoutFrequency >= 550000000.0)   return ADF4351_RFDIV_4; 
-    if (RFoutFrequency >= 275000000.0)   return ADF4351_RFDIV_8;
-    if (RFoutFrequency >=  137500000.0)   return ADF4351_RFDIV_16;
-    if (RFoutFrequency >=  68750000.0)   return ADF4351_RFDIV_32;
+#include "spi_transport.h"
+
+
+// Default device: the board's own synthesizer, behind ADF4351_Reg0..5
+ADF4351_Dev_t   ADF4351_Dev;
+uint32_t        ADF4351_WordsSent;      // Running count of 32-bit words shifted out, all devices
+
+// Where shadow n lives inside a device
+static const uint8_t ADF4351_ShadowOfs[6] = {
+    offsetof(ADF4351_Dev_t, Reg0), offsetof(ADF4351_Dev_t, Reg1), offsetof(ADF4351_Dev_t, Reg2),
+    offsetof(ADF4351_Dev_t, Reg3), offsetof(ADF4351_Dev_t, Reg4), offsetof(ADF4351_Dev_t, Reg5)
+};
+
+static uint32_t ADF4351_Shadow(const ADF4351_Dev_t *dev, uint8_t n)
+{
+    return *(const uint32_t *)((const uint8_t *)dev + ADF4351_ShadowOfs[n]);
+}
+
+// Private Helper: Select Output Divider (thresholds in kHz, VCO 2.2-4.4 GHz)
+static ADF4351_RFDIV_t ADF4351_Select_Output_Divider(uint32_t RFoutKHz)
+{
+    if (RFoutKHz >= 2200000UL) return ADF4351_RFDIV_1;
+    if (RFoutKHz >= 1100000UL) return ADF4351_RFDIV_2;
+    if (RFoutKHz >= 550000UL)  return ADF4351_RFDIV_4;
+    if (RFoutKHz >= 275000UL)  return ADF4351_RFDIV_8;
+    if (RFoutKHz >= 137500UL)  return ADF4351_RFDIV_16;
+    if (RFoutKHz >= 68750UL)   return ADF4351_RFDIV_32;
     return ADF4351_RFDIV_64;
 }
 
@@ -48,65 +46,147 @@ static int gcd_iter(uint32_t u, uint32_t v) {
     return u;
 }
 
+// Private Helper: Number of significant bits
+static uint8_t bitlen64(uint64_t v) {
+    uint8_t n = 0;
+    while (v) { n++; v >>= 1; }
+    return n;
+}
+
+// Private Helper: Resolve an exact FRAC rounding tie the way the old double
+// path did. N-INT is exactly (2x+1)/(2*MOD) here; the old code saw it rounded
+// to a 53-bit double, multiplied by MOD, rounded again and then round()ed,
+// so the tie breaks on the sign of those representation errors. Only runs
+// when the exact value sits on .5, which keeps the common path cheap.
+static uint16_t ADF4351_FracTie(uint16_t INT, uint16_t MOD, uint16_t x)
+{
+    uint8_t  F = 53 - bitlen64(INT);                // fraction bits of N as a double
+    uint64_t num = (uint64_t)(2U * x + 1U) << F;
+    uint64_t den = 2U * (uint64_t)MOD;
+    uint64_t k = num / den;
+    uint64_t r = num % den;
+    uint64_t prod;
+    uint8_t  L;
+
+    // 1. (double)N - INT, in units of 2^-F (round half to even)
+    if (2 * r > den || (2 * r == den && (k & 1))) k++;
+
+    // 2. Multiply by MOD and round to a 53-bit mantissa
+    prod = k * MOD;
+    L = bitlen64(prod);
+    if (L > 53) {
+        uint8_t  s = L - 53;
+        uint64_t half = 1ULL << (s - 1);
+        uint64_t m = prod & ((1ULL << s) - 1);
+        prod >>= s;
+        if (m > half || (m == half && (prod & 1))) prod++;
+        prod <<= s;
+    }
+
+    // 3. round(): anything at or above x + 0.5 goes up
+    return (prod >= ((uint64_t)(2U * x + 1U) << (F - 1))) ? x + 1 : x;
+}
+
 // Private Helper: Write 32-bit word
-static void ADF4351_WriteRegister32(uint32_t value) {
-    soft_spi_chip_enable();
-    soft_spi_transfer((uint8_t)((value >> 24) & 0xFF));
-    soft_spi_transfer((uint8_t)((value >> 16) & 0xFF));
-    soft_spi_transfer((uint8_t)((value >> 8)  & 0xFF));
-    soft_spi_transfer((uint8_t)((value)       & 0xFF));
-    soft_spi_chip_disable();
+static void ADF4351_WriteRegister32(const ADF4351_Dev_t *dev, uint32_t value) {
+    if (dev->Spi->write32) {
+        dev->Spi->write32(value);
+        return;
+    }
+    dev->Spi->chip_enable();
+    dev->Spi->transfer((uint8_t)((value >> 24) & 0xFF));
+    dev->Spi->transfer((uint8_t)((value >> 16) & 0xFF));
+    dev->Spi->transfer((uint8_t)((value >> 8)  & 0xFF));
+    dev->Spi->transfer((uint8_t)((value)       & 0xFF));
+    dev->Spi->chip_disable();
 }
 
-/** \brief Initialize Defaults with User "Golden" Values */
-void ADF4351_Init(void)
+/** \brief Select the SPI backend; must be called before any register write */
+void ADF4351_SetTransport(const spi_transport_t *transport)
+{
+    ADF4351_Dev.Spi = transport;
+}
+
+/** \brief Initialize Defaults with User "Golden" Values
+ *
+ *  transport may be NULL to keep the one already set on the device.
+ */
+void ADF4351_DevInit(ADF4351_Dev_t *dev, const spi_transport_t *transport)
 {
-    ADF4351_Reg0.w = R0_TEST;
-    ADF4351_Reg1.w = R1_TEST;
-    ADF4351_Reg2.w = R2_TEST;
-    ADF4351_Reg3.w = R3_TEST;
-    ADF4351_Reg4.w = R4_TEST;
-    ADF4351_Reg5.w = R5_TEST;
+    if (transport) dev->Spi = transport;
+    dev->Reg0.w = ADF4351_GOLDEN_R0;
+    dev->Reg1.w = ADF4351_GOLDEN_R1;
+    dev->Reg2.w = ADF4351_GOLDEN_R2;
+    dev->Reg3.w = ADF4351_GOLDEN_R3;
+    dev->Reg4.w = ADF4351_GOLDEN_R4;
+    dev->Reg5.w = ADF4351_GOLDEN_R5;
+    dev->WrittenValid = 0;           // Chip state unknown until the first write
+    dev->BandAnchorKHz = 0;
 }
 
-/** \brief Main Calculation Logic */
-ADF4351_ERR_t ADF4351_UpdateFrequencyRegisters(double RFout, double REFin, double OutputChannelSpacing, int gcd, int AutoBandSelectClock, double *RFoutCalc )
+/** \brief Main Calculation Logic (integer only)
+ *
+ *  RFoutKHz is in kHz so the full 35 MHz - 4.4 GHz range fits a uint32_t;
+ *  REFinHz and OutputChannelSpacingHz are in Hz. The PFD is kept as the exact
+ *  fraction REFin*Doubler / (Div2*R), so INT/FRAC/MOD/RfDivSel come out
+ *  identical to the previous double implementation without pulling in libm.
+ *  The achieved frequency is returned as an exact rational in Hz.
+ *
+ *  Works on Words only: R1 and R4 must hold the base values on entry, the
+ *  reference setup is read from the device's R2 shadow. No shadow is modified, so the
+ *  result can be staged while an ISR owns the shadows.
+ */
+ADF4351_ERR_t ADF4351_DevCalcFrequencyWords(const ADF4351_Dev_t *dev, uint32_t RFoutKHz, uint32_t REFinHz, uint32_t OutputChannelSpacingHz, int gcd, ADF4351_FreqWords_t *Words, ADF4351_Freq_t *RFoutCalc)
 {
+    ADF4351_Reg0_t  Reg0;
+    ADF4351_Reg1_t  Reg1;
+    ADF4351_Reg4_t  Reg4;
     ADF4351_RFDIV_t RfDivEnum;
     uint16_t        OutputDivider;
-    double          PFDFreq;                            
-    uint16_t        Rcounter;                           
-    int             RefDoubler;                     
-    int             RefD2;                          
-    double          N;
+    uint32_t        PFDNum;                             // PFD = PFDNum / PFDDen Hz
+    uint16_t        PFDDen;
+    uint64_t        NNum;                               // N = NNum / PFDNum
+    uint32_t        NRem;
+    uint64_t        FracNum;
     uint16_t        INT, MOD, FRAC;
     uint32_t        D;
 
+    Reg0.w = 0;
+    Reg1.w = Words->r1;
+    Reg4.w = Words->r4;
+
     // --- FORCE CONSTANTS FROM GOLDEN VALUES ---
-    ADF4351_Reg1.b.Prescaler = 1; // 8/9
-    ADF4351_Reg1.b.PhaseVal  = 1; 
-    ADF4351_Reg4.b.Feedback  = 1; 
+    Reg1.b.Prescaler = 1; // 8/9
+    Reg1.b.PhaseVal  = 1; 
+    Reg4.b.Feedback  = 1; 
+    Reg1.b.PhaseAdjust = 0;     // Stateless words always run the band select
 
     // 1. Get Ref Setup
-    RefD2 = ADF4351_Reg2.b.RDiv2 + 1;                   
-    RefDoubler = ADF4351_Reg2.b.RMul2 + 1;              
-    Rcounter = ADF4351_Reg2.b.RCountVal;
-    
-    // PFD Calculation
-    PFDFreq = (REFin * RefDoubler / RefD2) / Rcounter;
+    PFDNum = REFinHz * (dev->Reg2.b.RMul2 + 1);
+    PFDDen = (uint16_t)(dev->Reg2.b.RDiv2 + 1) * dev->Reg2.b.RCountVal;
 
     // 2. Select Output Divider
-    RfDivEnum = ADF4351_Select_Output_Divider(RFout);
-    ADF4351_Reg4.b.RfDivSel = RfDivEnum; 
+    RfDivEnum = ADF4351_Select_Output_Divider(RFoutKHz);
+    Reg4.b.RfDivSel = RfDivEnum; 
     OutputDivider = (1U << RfDivEnum);
 
-    // 3. Calculate N
-    N = ((RFout * OutputDivider) / PFDFreq);
+    // 3. Calculate N = RFout * OutputDivider / PFD
+    NNum = (uint64_t)RFoutKHz * 1000U * OutputDivider * PFDDen;
+
+    // 4. Calculate INT, MOD, FRAC (round half up, as round() did)
+    INT  = (uint16_t)(NNum / PFDNum);
+    NRem = (uint32_t)(NNum % PFDNum);
+    D    = (uint32_t)PFDDen * OutputChannelSpacingHz;
+    MOD  = (uint16_t)(((uint64_t)PFDNum * 2 + D) / ((uint64_t)D * 2));
+    FracNum = (uint64_t)NRem * MOD * 2;
+    FRAC = (uint16_t)((FracNum + PFDNum) / ((uint64_t)PFDNum * 2));
+    if ((FracNum % ((uint64_t)PFDNum * 2)) == PFDNum) {
+        FRAC = ADF4351_FracTie(INT, MOD, (uint16_t)(FracNum / ((uint64_t)PFDNum * 2)));
+    }
 
-    // 4. Calculate INT, MOD, FRAC
-    INT = (uint16_t)N;
-    MOD = (uint16_t)(round((PFDFreq / OutputChannelSpacing)));
-    FRAC = (uint16_t)(round(((double)N - INT) * MOD));
+    // FRAC rounded all the way up to MOD: carry into INT to stay in range.
+    // Before the GCD step, which would otherwise reduce FRAC == MOD to 1/1.
+    if (FRAC >= MOD) { INT++; FRAC -= MOD; }
 
     // 5. GCD Optimization
     if (gcd) {
@@ -114,26 +194,566 @@ ADF4351_ERR_t ADF4351_UpdateFrequencyRegisters(double RFout, double REFin, doubl
         MOD = MOD / D;
         FRAC = FRAC / D;
     }
-    if (MOD == 1) MOD = 2; 
+    // MOD 1 is not allowed: the same N over MOD 2
+    if (MOD == 1) { MOD = 2; FRAC *= 2; }
 
     // SAFETY CHECK: Ensure MOD doesn't overflow 12 bits (Max 4095)
     if (MOD > 4095) return ADF4351_Err_InvalidMOD;
 
     // Save Calculated Values
-    ADF4351_Reg0.b.FracVal = (FRAC & 0x0FFF);
-    ADF4351_Reg0.b.IntVal = (INT & 0xFFFF);
-    ADF4351_Reg1.b.ModVal = (MOD & 0x0FFF);
+    Reg0.b.FracVal = (FRAC & 0x0FFF);
+    Reg0.b.IntVal = (INT & 0xFFFF);
+    Reg1.b.ModVal = (MOD & 0x0FFF);
+    Words->r0 = Reg0.w;
+    Words->r1 = Reg1.w;
+    Words->r4 = Reg4.w;
+
+    // RFout = (INT + FRAC/MOD) * PFD / OutputDivider
+    if (RFoutCalc) {
+        RFoutCalc->Num = ((uint64_t)INT * MOD + FRAC) * PFDNum;
+        RFoutCalc->Den = (uint32_t)MOD * PFDDen * OutputDivider;
+    }
+
+    return ADF4351_Err_None;
+}
+
+// Private Helper: band select clock for the PFD, and skip the band select
+// (R1 PhaseAdjust) while the VCO stays near the last retune that ran it
+static void ADF4351_AutoBandSelect(ADF4351_Dev_t *dev, uint32_t RFoutKHz, uint32_t REFinHz)
+{
+    uint32_t VcoKHz;
+
+    // 1. Fastest band select clock the PFD allows
+    ADF4351_DevSetBandSelectClock(dev, REFinHz);
+
+    // 2. Small VCO moves stay in the calibrated band: skip the band select
+    VcoKHz = RFoutKHz << dev->Reg4.b.RfDivSel;
+    if (dev->BandAnchorKHz &&
+        (VcoKHz > dev->BandAnchorKHz ? VcoKHz - dev->BandAnchorKHz
+                                        : dev->BandAnchorKHz - VcoKHz) <= ADF4351_BANDSEL_SKIP_KHZ) {
+        dev->Reg1.b.PhaseAdjust = 1;
+    } else {
+        dev->BandAnchorKHz = VcoKHz;
+    }
+}
+
+/** \brief Solve RFout into the R0/R1/R4 shadows (see ADF4351_DevCalcFrequencyWords)
+ *
+ *  With AutoBandSelectClock the band select clock is set for the current
+ *  PFD (ADF4351_SetBandSelectClock), and the VCO band select is skipped
+ *  (R1 PhaseAdjust) while the VCO stays within ADF4351_BANDSEL_SKIP_KHZ of
+ *  the last retune that ran it. The shadows are assumed to be committed
+ *  before the next call; ADF4351_DevForceBandSelect() drops that history.
+ */
+ADF4351_ERR_t ADF4351_DevUpdateFrequencyRegisters(ADF4351_Dev_t *dev, uint32_t RFoutKHz, uint32_t REFinHz, uint32_t OutputChannelSpacingHz, int gcd, int AutoBandSelectClock, ADF4351_Freq_t *RFoutCalc)
+{
+    ADF4351_FreqWords_t Words;
+    ADF4351_ERR_t       err;
+
+    Words.r1 = dev->Reg1.w;
+    Words.r4 = dev->Reg4.w;
+    err = ADF4351_DevCalcFrequencyWords(dev, RFoutKHz, REFinHz, OutputChannelSpacingHz, gcd, &Words, RFoutCalc);
+    if (err != ADF4351_Err_None) return err;
+
+    dev->Reg0.w = Words.r0;
+    dev->Reg1.w = Words.r1;
+    dev->Reg4.w = Words.r4;
+    if (AutoBandSelectClock) ADF4351_AutoBandSelect(dev, RFoutKHz, REFinHz);
+    return ADF4351_Err_None;
+}
+
+/** \brief Load words solved earlier (ADF4351_DevCalcFrequencyWords) for RFoutKHz
+ *
+ *  Stored channels come back this way without a solve. Same band select
+ *  handling as ADF4351_DevUpdateFrequencyRegisters() with
+ *  AutoBandSelectClock; Words must be stateless (R1 PhaseAdjust clear).
+ */
+void ADF4351_DevLoadFrequencyWords(ADF4351_Dev_t *dev, uint32_t RFoutKHz, const ADF4351_FreqWords_t *Words, uint32_t REFinHz)
+{
+    dev->Reg0.w = Words->r0;
+    dev->Reg1.w = Words->r1;
+    dev->Reg4.w = Words->r4;
+    ADF4351_AutoBandSelect(dev, RFoutKHz, REFinHz);
+}
+
+// Private Helper: |x - y|
+static uint64_t absdiff64(uint64_t x, uint64_t y) {
+    return (x > y) ? x - y : y - x;
+}
+
+// Private Helper: Best rational approximation p/q of A/B (A < B) with
+// q <= qmax. Walks the continued fraction (Stern-Brocot descent) and ends
+// on the best semiconvergent once the next convergent no longer fits.
+// Returns the number of steps taken, at most ADF4351_EXACT_CF_STEPS.
+static uint8_t ADF4351_BestFraction(uint32_t A, uint32_t B, uint16_t qmax, uint16_t *p, uint16_t *q)
+{
+    uint32_t a = A, b = B;
+    uint32_t p0 = 0, q0 = 1;                    // Convergent k-2
+    uint32_t p1 = 1, q1 = 0;                    // Convergent k-1
+    uint8_t  steps = 0;
+
+    while (b != 0) {
+        uint32_t t = a / b;
+        uint32_t r = a - t * b;
+        uint32_t q2 = t * q1 + q0;
+        uint32_t p2;
+
+        steps++;
+        if (q2 > qmax) {
+            uint32_t k = (qmax - q0) / q1;
+            uint32_t ps = k * p1 + p0;
+            uint32_t qs = k * q1 + q0;
+            // |A/B - ps/qs| < |A/B - p1/q1|, cross-multiplied
+            if (k > 0 && absdiff64((uint64_t)A * qs, (uint64_t)ps * B) * q1
+                       < absdiff64((uint64_t)A * q1, (uint64_t)p1 * B) * qs) {
+                p1 = ps;
+                q1 = qs;
+            }
+            break;
+        }
+        p2 = t * p1 + p0;
+        p0 = p1; q0 = q1;
+        p1 = p2; q1 = q2;
+        a = b; b = r;
+    }
+    *p = (uint16_t)p1;
+    *q = (uint16_t)q1;
+    return steps;
+}
+
+uint16_t ADF4351_ExactIterations;       // CF steps used by the last exact solve
+
+/** \brief Exact mode: search the reference path for the least frequency error
+ *
+ *  Tries every doubler / divide-by-2 / R counter (1..ADF4351_EXACT_R_MAX)
+ *  combination whose PFD stays within ADF5451_PFD_MAX and gives a legal INT
+ *  (75..65535 with the 8/9 prescaler). For each, FRAC/MOD is the best
+ *  rational approximation with MOD <= 4095, so no channel spacing is
+ *  needed. Candidates are tried R = 1, 2, ... and within each R doubler
+ *  off then on, divide-by-2 off then on; ties keep the first one tried
+ *  and an exact hit ends the search. On success R0/R1/R2/R4 shadows are
+ *  updated and the new VCO becomes the band select anchor, since R1
+ *  leaves PhaseAdjust clear and the chip runs the band select. Worst case
+ *  is ADF4351_EXACT_MAX_ITER continued fraction steps (ADF4351_EXACT_MAX_CYCLES).
+ */
+ADF4351_ERR_t ADF4351_DevUpdateFrequencyRegistersExact(ADF4351_Dev_t *dev, uint32_t RFoutKHz, uint32_t REFinHz, ADF4351_Freq_t *RFoutCalc)
+{
+    ADF4351_RFDIV_t RfDivEnum;
+    uint16_t        OutputDivider;
+    uint64_t        VcoHz;
+    uint64_t        BestErr = UINT64_MAX;       // |error| in uHz
+    uint16_t        BestR = 0, BestINT = 0, BestFRAC = 0, BestMOD = 0;
+    uint8_t         BestDbl = 0, BestD2 = 0;
+    uint16_t        R;
+    uint8_t         Dbl, D2;
+
+    if (RFoutKHz > ADF4351_RFOUT_MAX) return ADF4351_Err_RFoutTooHigh;
+    if (RFoutKHz < ADF4351_RFOUTMIN)  return ADF4351_Err_RFoutTooLow;
+    if (REFinHz > ADF4351_REFINMAX)   return ADF4351_Err_REFinTooHigh;
+
+    RfDivEnum = ADF4351_Select_Output_Divider(RFoutKHz);
+    OutputDivider = (1U << RfDivEnum);
+    VcoHz = (uint64_t)RFoutKHz * 1000U * OutputDivider;
+    ADF4351_ExactIterations = 0;
+
+    for (R = 1; R <= ADF4351_EXACT_R_MAX && BestErr != 0; R++) {
+        for (Dbl = 0; Dbl < 2 && BestErr != 0; Dbl++) {
+            // The reference doubler is only specified up to 30 MHz input
+            if (Dbl && REFinHz > 30000000UL) continue;
+            for (D2 = 0; D2 < 2 && BestErr != 0; D2++) {
+                uint32_t PFDNum = REFinHz << Dbl;
+                uint16_t PFDDen = (uint16_t)(R << D2);
+                uint64_t NNum = VcoHz * PFDDen;
+                uint32_t INT, NRem;
+                uint16_t FRAC, MOD;
+                uint64_t Err;
+
+                if (PFDNum > (uint64_t)ADF5451_PFD_MAX * PFDDen) continue;
+                INT = (uint32_t)(NNum / PFDNum);
+                if (INT < 75 || INT > 65535) continue;
+                NRem = (uint32_t)(NNum - (uint64_t)INT * PFDNum);
+
+                ADF4351_ExactIterations += ADF4351_BestFraction(NRem, PFDNum, 4095, &FRAC, &MOD);
+                if (FRAC == MOD) { INT++; FRAC = 0; }     // Rounded up to the next integer
+                if (INT > 65535) continue;
+                if (MOD < 2) { MOD = 2; FRAC *= 2; }
 
-    *RFoutCalc = (((double)((double)INT + ((double)FRAC / (double)MOD)) * (double)PFDFreq / OutputDivider));
+                // |N - (INT + FRAC/MOD)| * PFD / OutputDivider, in uHz
+                Err = absdiff64(NNum * MOD, ((uint64_t)INT * MOD + FRAC) * PFDNum);
+                Err = (Err * 1000000UL) / ((uint32_t)MOD * PFDDen * OutputDivider);
+                if (Err < BestErr) {
+                    BestErr = Err;
+                    BestR = R; BestDbl = Dbl; BestD2 = D2;
+                    BestINT = (uint16_t)INT; BestFRAC = FRAC; BestMOD = MOD;
+                }
+            }
+        }
+    }
+    if (BestR == 0) return ADF4351_Err_PFD;
+
+    dev->Reg2.b.RCountVal = BestR;
+    dev->Reg2.b.RMul2     = BestDbl;
+    dev->Reg2.b.RDiv2     = BestD2;
+    dev->Reg1.b.Prescaler = 1;   // 8/9
+    dev->Reg1.b.PhaseVal  = 1;
+    dev->Reg1.b.ModVal    = BestMOD;
+    dev->Reg0.b.IntVal    = BestINT;
+    dev->Reg0.b.FracVal   = BestFRAC;
+    dev->Reg4.b.Feedback  = 1;
+    dev->Reg4.b.RfDivSel  = RfDivEnum;
+
+    // Band select clock for the new PFD; this write runs the band select
+    dev->Reg1.b.PhaseAdjust = 0;
+    ADF4351_DevSetBandSelectClock(dev, REFinHz);
+    dev->BandAnchorKHz = RFoutKHz << RfDivEnum;
 
+    if (RFoutCalc) {
+        RFoutCalc->Num = ((uint64_t)BestINT * BestMOD + BestFRAC) * (REFinHz << BestDbl);
+        RFoutCalc->Den = (uint32_t)BestMOD * ((uint32_t)BestR << BestD2) * OutputDivider;
+    }
     return ADF4351_Err_None;
 }
 
-void ADF4351_UpdateAllRegisters(void) {
-    ADF4351_WriteRegister32(ADF4351_Reg5.w);
-    ADF4351_WriteRegister32(ADF4351_Reg4.w);
-    ADF4351_WriteRegister32(ADF4351_Reg3.w);
-    ADF4351_WriteRegister32(ADF4351_Reg2.w);
-    ADF4351_WriteRegister32(ADF4351_Reg1.w);
-    ADF4351_WriteRegister32(ADF4351_Reg0.w);
-}
\ No newline at end of file
+/** \brief Range-check a solved register set against the datasheet limits
+ *
+ *  Words holds R0/R1/R4 as produced by a solver, R2 the reference setup
+ *  they were solved with. Checks PFD, MOD (2..4095), FRAC < MOD, INT for
+ *  the selected prescaler (75 for 8/9, 23 for 4/5), the RF divider code and
+ *  that the resulting VCO frequency is 2.2-4.4 GHz.
+ */
+ADF4351_ERR_t ADF4351_CheckWords(const ADF4351_FreqWords_t *Words, uint32_t R2, uint32_t REFinHz)
+{
+    ADF4351_Reg0_t Reg0;
+    ADF4351_Reg1_t Reg1;
+    ADF4351_Reg2_t Reg2;
+    ADF4351_Reg4_t Reg4;
+    uint32_t       PFDNum;
+    uint16_t       PFDDen;
+    uint64_t       VcoNum;                      // VCO = VcoNum / (MOD * PFDDen)
+    uint64_t       VcoDen;
+
+    Reg0.w = Words->r0;
+    Reg1.w = Words->r1;
+    Reg2.w = R2;
+    Reg4.w = Words->r4;
+
+    if (REFinHz > ADF4351_REFINMAX) return ADF4351_Err_REFinTooHigh;
+    if (Reg2.b.RCountVal == 0) return ADF4351_Err_PFD;
+    PFDNum = REFinHz * (Reg2.b.RMul2 + 1);
+    PFDDen = (uint16_t)(Reg2.b.RDiv2 + 1) * Reg2.b.RCountVal;
+    if (PFDNum > (uint64_t)ADF5451_PFD_MAX * PFDDen) return ADF4351_Err_PFD;
+
+    if (Reg1.b.ModVal < 2 || Reg0.b.FracVal >= Reg1.b.ModVal) return ADF4351_Err_InvalidMOD;
+    if (Reg0.b.IntVal < (Reg1.b.Prescaler ? 75 : 23)) return ADF4351_Err_InvalidN;
+    if (Reg4.b.RfDivSel > ADF4351_RFDIV_64) return ADF4351_Err_InvalidN;
+
+    VcoNum = ((uint64_t)Reg0.b.IntVal * Reg1.b.ModVal + Reg0.b.FracVal) * PFDNum;
+    VcoDen = (uint64_t)Reg1.b.ModVal * PFDDen;
+    if (VcoNum > (uint64_t)ADF4351_VCO_MAX_KHZ * 1000U * VcoDen) return ADF4351_Err_RFoutTooHigh;
+    if (VcoNum < (uint64_t)ADF4351_VCO_MIN_KHZ * 1000U * VcoDen) return ADF4351_Err_RFoutTooLow;
+
+    return ADF4351_Err_None;
+}
+
+// Private Helper: Write shadow register n and remember what the chip now holds
+static void ADF4351_WriteShadow(ADF4351_Dev_t *dev, uint8_t n) {
+    uint32_t value = ADF4351_Shadow(dev, n);
+    ADF4351_WriteRegister32(dev, value);
+    dev->Written[n] = value;
+    dev->WrittenValid |= (1 << n);
+    ADF4351_WordsSent++;
+}
+
+/** \brief Bit n set when shadow register n differs from what the chip holds */
+uint8_t ADF4351_DevDirtyMask(const ADF4351_Dev_t *dev)
+{
+    uint8_t mask = 0;
+    uint8_t n;
+
+    for (n = 0; n < 6; n++) {
+        if (!(dev->WrittenValid & (1 << n)) || ADF4351_Shadow(dev, n) != dev->Written[n])
+            mask |= (1 << n);
+    }
+    return mask;
+}
+
+// Private Helper: dirty registers plus the R0 write their double buffering needs
+static uint8_t ADF4351_CommitMask(const ADF4351_Dev_t *dev)
+{
+    uint8_t dirty = ADF4351_DevDirtyMask(dev);
+
+    if (dirty & ((1 << 1) | (1 << 2))) dirty |= (1 << 0);
+
+    if ((dirty & (1 << 4)) && dev->Reg2.b.DoubleBuffer) {
+        ADF4351_Reg4_t old;
+        old.w = dev->Written[4];
+        if (!(dev->WrittenValid & (1 << 4)) || old.b.RfDivSel != dev->Reg4.b.RfDivSel)
+            dirty |= (1 << 0);
+    }
+    return dirty;
+}
+
+/** \brief Write only the changed registers, R5 first and R0 last
+ *
+ *  MOD/phase (R1) and R counter, doubler, /2 and CP current (R2) are double
+ *  buffered and only take effect on the next R0 write, so R0 follows any
+ *  change there. RfDivSel in R4 is treated the same way when
+ *  R2 DoubleBuffer is set. Returns the number of words sent.
+ */
+uint8_t ADF4351_DevCommitRegisters(ADF4351_Dev_t *dev)
+{
+    uint8_t dirty = ADF4351_CommitMask(dev);
+    uint8_t sent = 0;
+    int8_t  n;
+
+    for (n = 5; n >= 0; n--) {
+        if (dirty & (1 << n)) {
+            ADF4351_WriteShadow(dev, n);
+            sent++;
+        }
+    }
+    return sent;
+}
+
+/** \brief Commit several devices over one bit-parallel bus
+ *
+ *  devs[i] sits on bus lane i. Register slots go out R5 first and R0 last
+ *  as in ADF4351_DevCommitRegisters(); each slot is one bus transfer that
+ *  carries the word of every device that needs it and latches them on the
+ *  same LE edge. All R0 words therefore land in the same instant, which is
+ *  what multi-LO retunes need. Lanes that share an LE pin latch on every
+ *  slot either of them takes part in, so a clean word is resent for them.
+ *  Returns the number of bus transfers.
+ */
+uint8_t ADF4351_CommitGroup(ADF4351_Dev_t *const *devs, uint8_t count, const spi_bus_t *bus)
+{
+    uint8_t  dirty[ADF4351_GROUP_MAX];
+    uint32_t words[ADF4351_GROUP_MAX];
+    uint8_t  slots = 0;
+    uint8_t  i, mask;
+    int8_t   n;
+
+    if (count > bus->lanes) count = bus->lanes;
+    if (count > ADF4351_GROUP_MAX) count = ADF4351_GROUP_MAX;
+    for (i = 0; i < count; i++) dirty[i] = ADF4351_CommitMask(devs[i]);
+
+    for (n = 5; n >= 0; n--) {
+        mask = 0;
+        for (i = 0; i < count; i++)
+            if (dirty[i] & (1 << n)) mask |= (1 << i);
+        if (!mask) continue;
+
+        // 1. Widen to whole LE groups, then take every lane's word
+        if (bus->le_group) mask = bus->le_group(mask) & (uint8_t)((1U << count) - 1);
+        for (i = 0; i < count; i++) {
+            if (!(mask & (1 << i))) continue;
+            words[i] = ADF4351_Shadow(devs[i], (uint8_t)n);
+            devs[i]->Written[n] = words[i];
+            devs[i]->WrittenValid |= (1 << n);
+            ADF4351_WordsSent++;
+        }
+
+        // 2. One transfer, one latch
+        bus->write32(words, mask);
+        slots++;
+    }
+    return slots;
+}
+
+void ADF4351_DevUpdateAllRegisters(ADF4351_Dev_t *dev) {
+    int8_t n;
+
+    for (n = 5; n >= 0; n--) ADF4351_WriteShadow(dev, n);
+}
+
+/** \brief Route digital lock detect to both LD and MUXOUT
+ *
+ *  Only the shadows change; the next commit sends R2 and R5. Whichever of
+ *  the two pins the board wires to the transport's lock_detect input then
+ *  follows the PLL.
+ */
+void ADF4351_DevEnableLockDetect(ADF4351_Dev_t *dev)
+{
+    dev->Reg2.b.MuxOut = ADF4351_MUXOUT_DLD;
+    dev->Reg5.b.LdPinMode = ADF4351_LDPIN_DLD;
+}
+
+/** \brief True when the transport can read the lock-detect pin */
+bool ADF4351_DevHasLockDetect(const ADF4351_Dev_t *dev)
+{
+    return dev->Spi && dev->Spi->lock_detect;
+}
+
+/** \brief Lock-detect pin level; true when no pin is wired */
+bool ADF4351_DevLocked(const ADF4351_Dev_t *dev)
+{
+    if (!ADF4351_DevHasLockDetect(dev)) return true;
+    return dev->Spi->lock_detect() != 0;
+}
+
+/** \brief Arm the fast-lock timer for the next R0 write, or disarm it
+ *
+ *  While the timer runs the chip widens the loop (SW1/SW2 switch in the
+ *  loop filter damping resistor, charge pump at 16x), then drops back to
+ *  the normal bandwidth. The timeout is ClkDivVal * MOD / fPFD, so it is
+ *  computed from the MOD in the R1 shadow: call after the frequency is
+ *  solved. TimeoutUs 0 turns fast lock off; a phase-resync setup in
+ *  ClkDivMod is left alone. Only the R3 shadow changes.
+ */
+void ADF4351_DevSetFastLock(ADF4351_Dev_t *dev, uint16_t TimeoutUs, uint32_t REFinHz)
+{
+    uint32_t PFDNum = REFinHz * (dev->Reg2.b.RMul2 + 1);
+    uint32_t PFDDen = (uint32_t)(dev->Reg2.b.RDiv2 + 1) * dev->Reg2.b.RCountVal;
+    uint64_t Den;
+    uint32_t ClkDiv;
+
+    if (dev->Reg3.b.ClkDivMod == ADF4351_CLKDIV_RESYNC) return;
+    if (TimeoutUs == 0 || PFDDen == 0 || dev->Reg1.b.ModVal == 0) {
+        dev->Reg3.b.ClkDivMod = ADF4351_CLKDIV_OFF;
+        return;
+    }
+
+    // ClkDivVal = ceil(t * fPFD / MOD), 1..4095
+    Den = (uint64_t)1000000UL * PFDDen * dev->Reg1.b.ModVal;
+    ClkDiv = (uint32_t)(((uint64_t)TimeoutUs * PFDNum + Den - 1) / Den);
+    if (ClkDiv < 1) ClkDiv = 1;
+    if (ClkDiv > 4095) ClkDiv = 4095;
+
+    dev->Reg3.b.ClkDivVal = ClkDiv;
+    dev->Reg3.b.ClkDivMod = ADF4351_CLKDIV_FASTLOCK;
+}
+
+/** \brief Fastest band select clock the PFD in the R2 shadow allows
+ *
+ *  High-speed mode (R3 BandSelMode) takes the clock to 500 kHz with a
+ *  divider of at most 254; below a 125 kHz PFD the low-speed mode with a
+ *  divider of 1 is already as fast as the PFD. Band select runs for
+ *  ADF4351_BANDSEL_CYCLES clocks, so at a 25 MHz PFD this is 20 us against
+ *  80 us for the golden divider of 200. Only the R3/R4 shadows change.
+ */
+void ADF4351_DevSetBandSelectClock(ADF4351_Dev_t *dev, uint32_t REFinHz)
+{
+    uint32_t PFDHz = (REFinHz * (dev->Reg2.b.RMul2 + 1)) /
+                     ((uint32_t)(dev->Reg2.b.RDiv2 + 1) * (dev->Reg2.b.RCountVal ? dev->Reg2.b.RCountVal : 1));
+    uint32_t Div = (PFDHz + ADF4351_BSC_HIGH_MAX_HZ - 1) / ADF4351_BSC_HIGH_MAX_HZ;
+
+    if (PFDHz > ADF4351_BSC_LOW_MAX_HZ && Div <= ADF4351_BSC_HIGH_DIV_MAX) {
+        dev->Reg3.b.BandSelMode = 1;
+    } else {
+        Div = (PFDHz + ADF4351_BSC_LOW_MAX_HZ - 1) / ADF4351_BSC_LOW_MAX_HZ;
+        dev->Reg3.b.BandSelMode = 0;
+    }
+    dev->Reg4.b.BandClkDiv = (Div > 255) ? 255 : (Div < 1 ? 1 : Div);
+}
+
+/** \brief Band select time the shadows will cause on the next R0 write
+ *
+ *  0 when R1 PhaseAdjust skips it. Adds directly to the write-to-lock time.
+ */
+uint32_t ADF4351_DevBandSelectTimeNs(const ADF4351_Dev_t *dev, uint32_t REFinHz)
+{
+    uint32_t PFDNum = REFinHz * (dev->Reg2.b.RMul2 + 1);
+    uint32_t PFDDen = (uint32_t)(dev->Reg2.b.RDiv2 + 1) * dev->Reg2.b.RCountVal;
+    uint32_t Div = dev->Reg4.b.BandClkDiv ? dev->Reg4.b.BandClkDiv : 1;
+
+    if (dev->Reg1.b.PhaseAdjust || PFDNum == 0) return 0;
+    return (uint32_t)(((uint64_t)ADF4351_BANDSEL_CYCLES * Div * PFDDen * 1000000000ULL) / PFDNum);
+}
+
+/** \brief RFout that the R0/R1/R2/R4 shadows give, rounded to kHz
+ *
+ *  For words that did not come from the solver, such as raw register
+ *  writes. 0 when MOD or the R counter is 0.
+ */
+uint32_t ADF4351_DevFrequencyKHz(const ADF4351_Dev_t *dev, uint32_t REFinHz)
+{
+    uint32_t PFDNum = REFinHz * (dev->Reg2.b.RMul2 + 1);
+    uint32_t PFDDen = (uint32_t)(dev->Reg2.b.RDiv2 + 1) * dev->Reg2.b.RCountVal;
+    uint32_t MOD = dev->Reg1.b.ModVal;
+    uint64_t Num, Den;
+
+    if (PFDDen == 0 || MOD == 0) return 0;
+    // RFout = PFD * (INT + FRAC / MOD), after the output divider only when it is outside the loop
+    Num = (uint64_t)PFDNum * ((uint32_t)dev->Reg0.b.IntVal * MOD + dev->Reg0.b.FracVal);
+    Den = (uint64_t)PFDDen * MOD * 1000UL;
+    if (dev->Reg4.b.Feedback) Den <<= dev->Reg4.b.RfDivSel;
+    return (uint32_t)((Num + Den / 2) / Den);
+}
+
+/** \brief Make the next ADF4351_DevUpdateFrequencyRegisters() run the band select */
+void ADF4351_DevForceBandSelect(ADF4351_Dev_t *dev)
+{
+    dev->BandAnchorKHz = 0;
+}
+
+/** \brief Load a compile-time preset into the shadows, no solver involved
+ *
+ *  The words are what ADF4351_DevUpdateFrequencyRegisters() would leave
+ *  after ADF4351_DevForceBandSelect(), so the preset VCO becomes the band
+ *  select anchor. Commit as usual.
+ */
+void ADF4351_DevLoadPreset(ADF4351_Dev_t *dev, const ADF4351_Preset_t *preset)
+{
+    dev->Reg0.w = preset->w[0];
+    dev->Reg1.w = preset->w[1];
+    dev->Reg2.w = preset->w[2];
+    dev->Reg3.w = preset->w[3];
+    dev->Reg4.w = preset->w[4];
+    dev->Reg5.w = preset->w[5];
+    dev->BandAnchorKHz = preset->VcoKHz;
+}
+
+// --- Single-device API: the same calls on ADF4351_Dev ---
+void ADF4351_Init(void)
+{
+    ADF4351_DevInit(&ADF4351_Dev, 0);
+}
+
+ADF4351_ERR_t ADF4351_CalcFrequencyWords(uint32_t RFoutKHz, uint32_t REFinHz, uint32_t OutputChannelSpacingHz, int gcd, ADF4351_FreqWords_t *Words, ADF4351_Freq_t *RFoutCalc)
+{
+    return ADF4351_DevCalcFrequencyWords(&ADF4351_Dev, RFoutKHz, REFinHz, OutputChannelSpacingHz, gcd, Words, RFoutCalc);
+}
+
+ADF4351_ERR_t ADF4351_UpdateFrequencyRegisters(uint32_t RFoutKHz, uint32_t REFinHz, uint32_t OutputChannelSpacingHz, int gcd, int AutoBandSelectClock, ADF4351_Freq_t *RFoutCalc)
+{
+    return ADF4351_DevUpdateFrequencyRegisters(&ADF4351_Dev, RFoutKHz, REFinHz, OutputChannelSpacingHz, gcd, AutoBandSelectClock, RFoutCalc);
+}
+
+ADF4351_ERR_t ADF4351_UpdateFrequencyRegistersExact(uint32_t RFoutKHz, uint32_t REFinHz, ADF4351_Freq_t *RFoutCalc)
+{
+    return ADF4351_DevUpdateFrequencyRegistersExact(&ADF4351_Dev, RFoutKHz, REFinHz, RFoutCalc);
+}
+
+void ADF4351_LoadFrequencyWords(uint32_t RFoutKHz, const ADF4351_FreqWords_t *Words, uint32_t REFinHz)
+{
+    ADF4351_DevLoadFrequencyWords(&ADF4351_Dev, RFoutKHz, Words, REFinHz);
+}
+
+void ADF4351_UpdateAllRegisters(void)           { ADF4351_DevUpdateAllRegisters(&ADF4351_Dev); }
+uint8_t ADF4351_DirtyMask(void)                 { return ADF4351_DevDirtyMask(&ADF4351_Dev); }
+uint8_t ADF4351_CommitRegisters(void)           { return ADF4351_DevCommitRegisters(&ADF4351_Dev); }
+void ADF4351_EnableLockDetect(void)             { ADF4351_DevEnableLockDetect(&ADF4351_Dev); }
+bool ADF4351_HasLockDetect(void)                { return ADF4351_DevHasLockDetect(&ADF4351_Dev); }
+bool ADF4351_Locked(void)                       { return ADF4351_DevLocked(&ADF4351_Dev); }
+void ADF4351_ForceBandSelect(void)              { ADF4351_DevForceBandSelect(&ADF4351_Dev); }
+void ADF4351_LoadPreset(const ADF4351_Preset_t *preset) { ADF4351_DevLoadPreset(&ADF4351_Dev, preset); }
+
+void ADF4351_SetFastLock(uint16_t TimeoutUs, uint32_t REFinHz)
+{
+    ADF4351_DevSetFastLock(&ADF4351_Dev, TimeoutUs, REFinHz);
+}
+
+void ADF4351_SetBandSelectClock(uint32_t REFinHz)
+{
+    ADF4351_DevSetBandSelectClock(&ADF4351_Dev, REFinHz);
+}
+
+uint32_t ADF4351_BandSelectTimeNs(uint32_t REFinHz)
+{
+    return ADF4351_DevBandSelectTimeNs(&ADF4351_Dev, REFinHz);
+}
+
+uint32_t ADF4351_FrequencyKHz(uint32_t REFinHz)
+{
+    return ADF4351_DevFrequencyKHz(&ADF4351_Dev, REFinHz);
+}
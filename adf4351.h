@@ -10,12 +10,50 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "spi_transport.h"
 
 // --- Constants from Datasheet ---
-#define ADF5451_PFD_MAX         32.0e6
-#define ADF4351_RFOUT_MAX       4400.0e6
-#define ADF4351_RFOUTMIN        35.000e6
-#define ADF4351_REFINMAX        250.0e6
+#define ADF5451_PFD_MAX         32000000UL      // Hz
+#define ADF4351_RFOUT_MAX       4400000UL       // kHz
+#define ADF4351_RFOUTMIN        35000UL         // kHz
+#define ADF4351_REFINMAX        250000000UL     // Hz
+#define ADF4351_VCO_MIN_KHZ     2200000UL       // kHz
+#define ADF4351_VCO_MAX_KHZ     4400000UL       // kHz
+
+// --- Golden register values, loaded by ADF4351_Init() ---
+// Gathered from the ADF435x software from Analog Devices: https://www.analog.com/en/resources/evaluation-hardware-and-software/evaluation-boards-kits/eval-adf4351.html#eb-relatedsoftware
+#define ADF4351_GOLDEN_R0 0x00418008	// 0000 0000 0100 0001 1000 0000 0000 1000	 ALL MSB FIRST TX
+#define ADF4351_GOLDEN_R1 0x08008029	// 0000 1000 0000 0000 1000 0000 0010 1001
+#define ADF4351_GOLDEN_R2 0x00004E42	// 0000 0000 0000 0000 0100 1110 0100 0010		
+#define ADF4351_GOLDEN_R3 0x000004B3	// 0000 0000 0000 0000 0000 0100 1011 0011
+#define ADF4351_GOLDEN_R4 0x00BC803C	// 0000 0000 1011 1100 1000 0000 0011 1100
+#define ADF4351_GOLDEN_R5 0x00580005	// 0000 0000 0101 1000 0000 0000 0000 0101
+
+// --- Exact mode search bounds ---
+#define ADF4351_EXACT_R_MAX     8               // R counter values tried
+#define ADF4351_EXACT_CF_STEPS  20              // Worst case per candidate: MOD <= 4095 < F(20)
+#define ADF4351_EXACT_MAX_ITER  (4 * ADF4351_EXACT_R_MAX * ADF4351_EXACT_CF_STEPS)
+// AVR cycle bound for one exact solve, from libgcc routine costs: a CF step
+// is a 32-bit divide/modulo and two 32-bit multiply-adds (<= 1600 cycles);
+// each of the 4 * R_MAX candidates adds two 64-bit divides, five 64-bit
+// multiplies and the final convergent check (<= 17500 cycles). About
+// 1.6 M cycles, ~145 ms at 11.0592 MHz: main loop only, never from an ISR
+#define ADF4351_EXACT_MAX_CYCLES \
+    (1600UL * ADF4351_EXACT_MAX_ITER + 17500UL * 4 * ADF4351_EXACT_R_MAX)
+
+// --- Lock detect and clock divider modes ---
+#define ADF4351_MUXOUT_DLD      6               // R2 MuxOut: digital lock detect
+#define ADF4351_LDPIN_DLD       1               // R5 LdPinMode: digital lock detect
+#define ADF4351_CLKDIV_OFF      0               // R3 ClkDivMod
+#define ADF4351_CLKDIV_FASTLOCK 1
+#define ADF4351_CLKDIV_RESYNC   2
+
+// --- VCO band select ---
+#define ADF4351_BSC_LOW_MAX_HZ  125000UL        // Band select clock, R3 BandSelMode = 0
+#define ADF4351_BSC_HIGH_MAX_HZ 500000UL        // Band select clock, R3 BandSelMode = 1
+#define ADF4351_BSC_HIGH_DIV_MAX 254            // BandClkDiv limit in high-speed mode
+#define ADF4351_BANDSEL_CYCLES  10              // Band select clocks per calibration
+#define ADF4351_BANDSEL_SKIP_KHZ 1000UL         // VCO drift allowed without band select
 
 /** \brief  Union type for Register 0 */
 typedef union {
@@ -136,17 +174,95 @@ typedef enum {
     ADF4351_Warn_NotTuned
 } ADF4351_ERR_t;
 
+/** \brief Exact frequency in Hz, expressed as Num / Den */
+typedef struct {
+    uint64_t Num;
+    uint32_t Den;
+} ADF4351_Freq_t;
+
+/** \brief The frequency-dependent register words */
+typedef struct {
+    uint32_t r0;
+    uint32_t r1;
+    uint32_t r4;
+} ADF4351_FreqWords_t;
+
+/** \brief All six words for one frequency, built at compile time (adf4351_preset.h) */
+typedef struct {
+    uint32_t w[6];                      // R0..R5
+    uint32_t VcoKHz;                    // VCO the band select calibrates to
+} ADF4351_Preset_t;
+
+/** \brief One synthesizer: register shadows, what the chip holds, its transport */
+typedef struct {
+    ADF4351_Reg0_t Reg0;
+    ADF4351_Reg1_t Reg1;
+    ADF4351_Reg2_t Reg2;
+    ADF4351_Reg3_t Reg3;
+    ADF4351_Reg4_t Reg4;
+    ADF4351_Reg5_t Reg5;
+    uint32_t       Written[6];          // Last latched words, to skip unchanged ones
+    uint8_t        WrittenValid;        // Bit n set: Written[n] is what the chip holds
+    uint32_t       BandAnchorKHz;       // VCO of the last retune that ran the band select, 0 if unknown
+    const spi_transport_t *Spi;
+} ADF4351_Dev_t;
+
+// Most devices CommitGroup() drives at once
+#define ADF4351_GROUP_MAX       8
+
 // --- External Access to Shadows ---
-extern ADF4351_Reg0_t ADF4351_Reg0;
-extern ADF4351_Reg1_t ADF4351_Reg1;
-extern ADF4351_Reg2_t ADF4351_Reg2;
-extern ADF4351_Reg3_t ADF4351_Reg3;
-extern ADF4351_Reg4_t ADF4351_Reg4;
-extern ADF4351_Reg5_t ADF4351_Reg5;
+// The single-device API works on ADF4351_Dev; its shadows keep their old names
+extern ADF4351_Dev_t  ADF4351_Dev;
+#define ADF4351_Reg0    (ADF4351_Dev.Reg0)
+#define ADF4351_Reg1    (ADF4351_Dev.Reg1)
+#define ADF4351_Reg2    (ADF4351_Dev.Reg2)
+#define ADF4351_Reg3    (ADF4351_Dev.Reg3)
+#define ADF4351_Reg4    (ADF4351_Dev.Reg4)
+#define ADF4351_Reg5    (ADF4351_Dev.Reg5)
+extern uint32_t       ADF4351_WordsSent;
+extern uint16_t       ADF4351_ExactIterations;
 
 // --- API Functions ---
+void ADF4351_SetTransport(const spi_transport_t *transport);
 void ADF4351_Init(void);
-ADF4351_ERR_t ADF4351_UpdateFrequencyRegisters(double RFout, double REFin, double OutputChannelSpacing, int gcd, int AutoBandSelectClock, double *RFoutCalc);
+ADF4351_ERR_t ADF4351_CalcFrequencyWords(uint32_t RFoutKHz, uint32_t REFinHz, uint32_t OutputChannelSpacingHz, int gcd, ADF4351_FreqWords_t *Words, ADF4351_Freq_t *RFoutCalc);
+ADF4351_ERR_t ADF4351_UpdateFrequencyRegisters(uint32_t RFoutKHz, uint32_t REFinHz, uint32_t OutputChannelSpacingHz, int gcd, int AutoBandSelectClock, ADF4351_Freq_t *RFoutCalc);
+ADF4351_ERR_t ADF4351_CheckWords(const ADF4351_FreqWords_t *Words, uint32_t R2, uint32_t REFinHz);
+void ADF4351_LoadFrequencyWords(uint32_t RFoutKHz, const ADF4351_FreqWords_t *Words, uint32_t REFinHz);
+ADF4351_ERR_t ADF4351_UpdateFrequencyRegistersExact(uint32_t RFoutKHz, uint32_t REFinHz, ADF4351_Freq_t *RFoutCalc);
 void ADF4351_UpdateAllRegisters(void);
+uint8_t ADF4351_DirtyMask(void);
+uint8_t ADF4351_CommitRegisters(void);
+void ADF4351_EnableLockDetect(void);
+bool ADF4351_HasLockDetect(void);
+bool ADF4351_Locked(void);
+void ADF4351_SetFastLock(uint16_t TimeoutUs, uint32_t REFinHz);
+void ADF4351_SetBandSelectClock(uint32_t REFinHz);
+uint32_t ADF4351_BandSelectTimeNs(uint32_t REFinHz);
+uint32_t ADF4351_FrequencyKHz(uint32_t REFinHz);
+void ADF4351_ForceBandSelect(void);
+void ADF4351_LoadPreset(const ADF4351_Preset_t *preset);
+
+// --- Instance API: any number of devices, each with its own transport ---
+void ADF4351_DevInit(ADF4351_Dev_t *dev, const spi_transport_t *transport);
+ADF4351_ERR_t ADF4351_DevCalcFrequencyWords(const ADF4351_Dev_t *dev, uint32_t RFoutKHz, uint32_t REFinHz, uint32_t OutputChannelSpacingHz, int gcd, ADF4351_FreqWords_t *Words, ADF4351_Freq_t *RFoutCalc);
+ADF4351_ERR_t ADF4351_DevUpdateFrequencyRegisters(ADF4351_Dev_t *dev, uint32_t RFoutKHz, uint32_t REFinHz, uint32_t OutputChannelSpacingHz, int gcd, int AutoBandSelectClock, ADF4351_Freq_t *RFoutCalc);
+void ADF4351_DevLoadFrequencyWords(ADF4351_Dev_t *dev, uint32_t RFoutKHz, const ADF4351_FreqWords_t *Words, uint32_t REFinHz);
+ADF4351_ERR_t ADF4351_DevUpdateFrequencyRegistersExact(ADF4351_Dev_t *dev, uint32_t RFoutKHz, uint32_t REFinHz, ADF4351_Freq_t *RFoutCalc);
+void ADF4351_DevUpdateAllRegisters(ADF4351_Dev_t *dev);
+uint8_t ADF4351_DevDirtyMask(const ADF4351_Dev_t *dev);
+uint8_t ADF4351_DevCommitRegisters(ADF4351_Dev_t *dev);
+void ADF4351_DevEnableLockDetect(ADF4351_Dev_t *dev);
+bool ADF4351_DevHasLockDetect(const ADF4351_Dev_t *dev);
+bool ADF4351_DevLocked(const ADF4351_Dev_t *dev);
+void ADF4351_DevSetFastLock(ADF4351_Dev_t *dev, uint16_t TimeoutUs, uint32_t REFinHz);
+void ADF4351_DevSetBandSelectClock(ADF4351_Dev_t *dev, uint32_t REFinHz);
+uint32_t ADF4351_DevBandSelectTimeNs(const ADF4351_Dev_t *dev, uint32_t REFinHz);
+uint32_t ADF4351_DevFrequencyKHz(const ADF4351_Dev_t *dev, uint32_t REFinHz);
+void ADF4351_DevForceBandSelect(ADF4351_Dev_t *dev);
+void ADF4351_DevLoadPreset(ADF4351_Dev_t *dev, const ADF4351_Preset_t *preset);
+
+// Several devices on one bit-parallel bus, latched together
+uint8_t ADF4351_CommitGroup(ADF4351_Dev_t *const *devs, uint8_t count, const spi_bus_t *bus);
 
 #endif /* _ADF4351_H_ */
\ No newline at end of file
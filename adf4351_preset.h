@@ -0,0 +1,117 @@
+/**
+ * @file     adf4351_preset.h
+ * @brief    Compile-time ADF4351 register words for fixed frequencies
+ * @date     16 October 2026
+ *
+ * Integer constant expressions that follow ADF4351_UpdateFrequencyRegisters()
+ * step by step (gcd off, automatic band select clock, band select run), so a
+ * fixed-frequency build can load its words with ADF4351_LoadPreset() and
+ * never call the solver. The base words are the golden ones ADF4351_Init()
+ * loads; the reference setup comes from ADF4351_PRESET_R2.
+ *
+ *   static ADF4351_PRESET_DEFINE(lo_preset, 868000UL, 25000000UL, 100000UL);
+ *
+ * Out-of-range setups fail the build. So does a FRAC that lands exactly on
+ * a rounding tie: the runtime solver breaks those the way the old double
+ * code did, which is not worth mirroring here, so move the preset by 1 kHz
+ * or use the solver. host/presetcheck.c compares these macros against the
+ * runtime solver over the whole band.
+ */
+
+#ifndef ADF4351_PRESET_H_
+#define ADF4351_PRESET_H_
+
+#include "adf4351.h"
+
+// R2 the preset is computed for: golden reference setup, lock detect on MUXOUT
+#ifndef ADF4351_PRESET_R2
+#define ADF4351_PRESET_R2       (ADF4351_GOLDEN_R2 | ((uint32_t)ADF4351_MUXOUT_DLD << 26))
+#endif
+#define ADF4351_PRESET_R5       (ADF4351_GOLDEN_R5 | ((uint32_t)ADF4351_LDPIN_DLD << 22))
+
+// --- Reference setup (R2 RCountVal, RDiv2, RMul2) ---
+#define ADF4351_PRESET_RCOUNT   ((uint32_t)((ADF4351_PRESET_R2 >> 14) & 0x3FF))
+#define ADF4351_PRESET_RDIV2    ((uint32_t)((ADF4351_PRESET_R2 >> 24) & 1))
+#define ADF4351_PRESET_RMUL2    ((uint32_t)((ADF4351_PRESET_R2 >> 25) & 1))
+
+// PFD = PFDNUM / PFDDEN Hz
+#define ADF4351_PRESET_PFDNUM(ref)  ((uint64_t)(ref) * (ADF4351_PRESET_RMUL2 + 1))
+#define ADF4351_PRESET_PFDDEN       ((ADF4351_PRESET_RDIV2 + 1) * ADF4351_PRESET_RCOUNT)
+
+// --- Output divider (same thresholds as the solver) ---
+#define ADF4351_PRESET_DIV(k) \
+    ((k) >= 2200000UL ? 0 : (k) >= 1100000UL ? 1 : (k) >= 550000UL ? 2 : \
+     (k) >= 275000UL  ? 3 : (k) >= 137500UL  ? 4 : (k) >= 68750UL   ? 5 : 6)
+
+// --- N = NNUM / PFDNUM, MOD and FRAC rounded half up ---
+#define ADF4351_PRESET_NNUM(k) \
+    ((uint64_t)(k) * 1000U * (1U << ADF4351_PRESET_DIV(k)) * ADF4351_PRESET_PFDDEN)
+#define ADF4351_PRESET_INT0(k, ref)     (ADF4351_PRESET_NNUM(k) / ADF4351_PRESET_PFDNUM(ref))
+#define ADF4351_PRESET_NREM(k, ref)     (ADF4351_PRESET_NNUM(k) % ADF4351_PRESET_PFDNUM(ref))
+#define ADF4351_PRESET_MOD0(ref, sp) \
+    ((ADF4351_PRESET_PFDNUM(ref) * 2 + (uint64_t)ADF4351_PRESET_PFDDEN * (sp)) / \
+     ((uint64_t)ADF4351_PRESET_PFDDEN * (sp) * 2))
+#define ADF4351_PRESET_FRACNUM(k, ref, sp) \
+    (ADF4351_PRESET_NREM(k, ref) * ADF4351_PRESET_MOD0(ref, sp) * 2)
+#define ADF4351_PRESET_FRAC0(k, ref, sp) \
+    ((ADF4351_PRESET_FRACNUM(k, ref, sp) + ADF4351_PRESET_PFDNUM(ref)) / (ADF4351_PRESET_PFDNUM(ref) * 2))
+#define ADF4351_PRESET_TIE(k, ref, sp) \
+    (ADF4351_PRESET_FRACNUM(k, ref, sp) % (ADF4351_PRESET_PFDNUM(ref) * 2) == ADF4351_PRESET_PFDNUM(ref))
+
+// FRAC rounded up to MOD carries into INT; MOD 1 becomes 2, where the
+// carried FRAC is always 0
+#define ADF4351_PRESET_MOD(ref, sp) \
+    (ADF4351_PRESET_MOD0(ref, sp) == 1 ? 2 : ADF4351_PRESET_MOD0(ref, sp))
+#define ADF4351_PRESET_CARRY(k, ref, sp) \
+    (ADF4351_PRESET_FRAC0(k, ref, sp) >= ADF4351_PRESET_MOD0(ref, sp))
+#define ADF4351_PRESET_INT(k, ref, sp) \
+    (ADF4351_PRESET_INT0(k, ref) + ADF4351_PRESET_CARRY(k, ref, sp))
+#define ADF4351_PRESET_FRAC(k, ref, sp) \
+    (ADF4351_PRESET_FRAC0(k, ref, sp) - (ADF4351_PRESET_CARRY(k, ref, sp) ? ADF4351_PRESET_MOD0(ref, sp) : 0))
+
+// --- Band select clock (see ADF4351_DevSetBandSelectClock) ---
+#define ADF4351_PRESET_PFDHZ(ref)   ((uint32_t)(ADF4351_PRESET_PFDNUM(ref) / ADF4351_PRESET_PFDDEN))
+#define ADF4351_PRESET_BSC_HIGH(ref) \
+    (ADF4351_PRESET_PFDHZ(ref) > ADF4351_BSC_LOW_MAX_HZ && \
+     (ADF4351_PRESET_PFDHZ(ref) + ADF4351_BSC_HIGH_MAX_HZ - 1) / ADF4351_BSC_HIGH_MAX_HZ <= ADF4351_BSC_HIGH_DIV_MAX)
+#define ADF4351_PRESET_BSC_DIV0(ref) \
+    (ADF4351_PRESET_BSC_HIGH(ref) ? \
+     (ADF4351_PRESET_PFDHZ(ref) + ADF4351_BSC_HIGH_MAX_HZ - 1) / ADF4351_BSC_HIGH_MAX_HZ : \
+     (ADF4351_PRESET_PFDHZ(ref) + ADF4351_BSC_LOW_MAX_HZ - 1) / ADF4351_BSC_LOW_MAX_HZ)
+#define ADF4351_PRESET_BSC_DIV(ref) \
+    (ADF4351_PRESET_BSC_DIV0(ref) > 255 ? 255 : ADF4351_PRESET_BSC_DIV0(ref) < 1 ? 1 : ADF4351_PRESET_BSC_DIV0(ref))
+
+// --- The six words ---
+#define ADF4351_PRESET_R0(k, ref, sp) \
+    ((uint32_t)(((ADF4351_PRESET_INT(k, ref, sp) & 0xFFFF) << 15) | ((ADF4351_PRESET_FRAC(k, ref, sp) & 0x0FFF) << 3)))
+#define ADF4351_PRESET_R1(ref, sp) \
+    ((uint32_t)((ADF4351_GOLDEN_R1 & ~0x1FFFFFF8UL) | (1UL << 27) | (1UL << 15) | \
+                ((ADF4351_PRESET_MOD(ref, sp) & 0x0FFF) << 3)))
+#define ADF4351_PRESET_R3(ref) \
+    ((uint32_t)((ADF4351_GOLDEN_R3 & ~(1UL << 23)) | ((uint32_t)ADF4351_PRESET_BSC_HIGH(ref) << 23)))
+#define ADF4351_PRESET_R4(k, ref) \
+    ((uint32_t)((ADF4351_GOLDEN_R4 & ~0x00FFF000UL) | (1UL << 23) | \
+                ((uint32_t)ADF4351_PRESET_DIV(k) << 20) | ((uint32_t)ADF4351_PRESET_BSC_DIV(ref) << 12)))
+
+/** \brief Initializer for an ADF4351_Preset_t, no checks (see ADF4351_PRESET_DEFINE) */
+#define ADF4351_PRESET(k, ref, sp) { \
+    { ADF4351_PRESET_R0(k, ref, sp), ADF4351_PRESET_R1(ref, sp), (uint32_t)ADF4351_PRESET_R2, \
+      ADF4351_PRESET_R3(ref), ADF4351_PRESET_R4(k, ref), (uint32_t)ADF4351_PRESET_R5 }, \
+    (uint32_t)(k) << ADF4351_PRESET_DIV(k) }
+
+/** \brief Define a checked preset: RFout in kHz, REFin and channel spacing in Hz
+ *
+ *  May be prefixed with static; needs the trailing semicolon.
+ */
+#define ADF4351_PRESET_DEFINE(name, k, ref, sp) \
+    const ADF4351_Preset_t name = ADF4351_PRESET(k, ref, sp); \
+    _Static_assert((k) >= ADF4351_RFOUTMIN && (k) <= ADF4351_RFOUT_MAX, "ADF4351 preset: RFout out of range"); \
+    _Static_assert((ref) <= ADF4351_REFINMAX, "ADF4351 preset: REFin too high"); \
+    _Static_assert(ADF4351_PRESET_PFDDEN != 0, "ADF4351 preset: R counter is 0"); \
+    _Static_assert(ADF4351_PRESET_PFDHZ(ref) <= ADF5451_PFD_MAX, "ADF4351 preset: PFD above 32 MHz"); \
+    _Static_assert(ADF4351_PRESET_MOD0(ref, sp) <= 4095, "ADF4351 preset: MOD above 4095, widen the spacing"); \
+    _Static_assert(ADF4351_PRESET_INT(k, ref, sp) >= 75 && ADF4351_PRESET_INT(k, ref, sp) <= 65535, \
+                   "ADF4351 preset: INT out of range for the 8/9 prescaler"); \
+    _Static_assert(!ADF4351_PRESET_TIE(k, ref, sp), "ADF4351 preset: FRAC rounding tie, move by 1 kHz")
+
+#endif /* ADF4351_PRESET_H_ */
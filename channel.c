@@ -0,0 +1,258 @@
+/**
+ * @file     channel.c
+ * @brief    Memory channels in EEPROM, stored with their solved words
+ * @date     16 October 2026
+ */
+
+#include <stddef.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+#include "channel.h"
+#include "retune.h"
+
+#define CHANNEL_RINGS           (CHANNEL_COUNT + 1)
+#define CHANNEL_NONE            0xFF
+#define CHANNEL_EE_BYTES \
+    ((CHANNEL_COUNT * CHANNEL_SLOTS + CHANNEL_LAST_SLOTS) * sizeof(channel_rec_t))
+
+_Static_assert(sizeof(channel_rec_t) == 20, "channel_rec_t must not be padded");
+_Static_assert(CHANNEL_EE_BYTES <= E2END + 1, "Channels do not fit the EEPROM");
+
+typedef struct {
+    uint16_t      addr;
+    channel_rec_t rec;
+} channel_job_t;
+
+static uint32_t channel_refin_hz;
+static uint32_t channel_spacing_hz;
+
+// Newest record of each ring: boot scan, then every store
+static uint8_t  channel_slot[CHANNEL_RINGS];        // CHANNEL_NONE: empty
+static uint8_t  channel_seq[CHANNEL_RINGS];
+static uint8_t  channel_flags[CHANNEL_RINGS];
+static uint32_t channel_khz[CHANNEL_RINGS];
+
+// Records waiting for the EEPROM, drained by the EE_RDY ISR
+static channel_job_t    channel_queue[CHANNEL_QUEUE_LEN];
+static volatile uint8_t channel_q_head;
+static volatile uint8_t channel_q_count;
+static volatile uint8_t channel_q_byte;             // Next byte of the head record
+
+// EEPROM address of a slot; CHANNEL_LAST is the last ring, so its longer
+// ring does not move the others
+static uint16_t channel_addr(uint8_t ring, uint8_t slot)
+{
+    return ((uint16_t)ring * CHANNEL_SLOTS + slot) * sizeof(channel_rec_t);
+}
+
+static uint8_t channel_ring_slots(uint8_t ring)
+{
+    return (ring == CHANNEL_LAST) ? CHANNEL_LAST_SLOTS : CHANNEL_SLOTS;
+}
+
+// Sum of everything before the check byte; an erased slot never matches
+static uint8_t channel_check(const channel_rec_t *rec)
+{
+    const uint8_t *p = (const uint8_t *)rec;
+    uint8_t sum = 0x5A;
+    uint8_t i;
+
+    for (i = 0; i < offsetof(channel_rec_t, check); i++) sum += p[i];
+    return sum;
+}
+
+static bool channel_valid(const channel_rec_t *rec, uint8_t ring)
+{
+    return rec->check == channel_check(rec) && rec->ring == ring &&
+           rec->khz >= ADF4351_RFOUTMIN && rec->khz <= ADF4351_RFOUT_MAX;
+}
+
+/** \brief Find the newest record of every ring; call once at boot
+ *
+ *  Stores solve with REFin and the channel spacing given here.
+ */
+void Channel_Init(uint32_t refin_hz, uint32_t spacing_hz)
+{
+    channel_rec_t rec;
+    uint8_t ring, slot;
+
+    channel_refin_hz = refin_hz;
+    channel_spacing_hz = spacing_hz;
+    channel_q_head = 0;
+    channel_q_count = 0;
+    channel_q_byte = 0;
+
+    for (ring = 0; ring < CHANNEL_RINGS; ring++) {
+        channel_slot[ring] = CHANNEL_NONE;
+        for (slot = 0; slot < channel_ring_slots(ring); slot++) {
+            eeprom_read_block(&rec, (const void *)(uintptr_t)channel_addr(ring, slot), sizeof(rec));
+            if (!channel_valid(&rec, ring)) continue;
+            if (channel_slot[ring] != CHANNEL_NONE && (int8_t)(rec.seq - channel_seq[ring]) <= 0) continue;
+            channel_slot[ring] = slot;
+            channel_seq[ring] = rec.seq;
+            channel_flags[ring] = rec.flags;
+            channel_khz[ring] = rec.khz;
+        }
+    }
+}
+
+/** \brief Solve khz and queue it for channel ch (or CHANNEL_LAST)
+ *
+ *  Returns at once; the EE_RDY ISR writes the record. A store to a channel
+ *  whose record is still queued and not completely written replaces that
+ *  record. Storing what the channel already holds writes nothing. False
+ *  when ch is out of range, the solver fails or the queue is full.
+ */
+bool Channel_Store(uint8_t ch, uint32_t khz, bool output_on)
+{
+    channel_job_t *job = 0;
+    channel_rec_t  rec;
+    uint8_t        flags = output_on ? CHANNEL_FLAG_ON : 0;
+    uint8_t        sreg;
+    uint8_t        i;
+
+    if (ch >= CHANNEL_RINGS) return false;
+    if (channel_slot[ch] != CHANNEL_NONE && channel_khz[ch] == khz && channel_flags[ch] == flags) return true;
+
+    // 1. Stateless words, so a recall runs the band select like a solve
+    rec.words.r1 = ADF4351_Reg1.w;
+    rec.words.r4 = ADF4351_Reg4.w;
+    if (ADF4351_CalcFrequencyWords(khz, channel_refin_hz, channel_spacing_hz, 0, &rec.words, 0) != ADF4351_Err_None) {
+        return false;
+    }
+    rec.khz = khz;
+    rec.flags = flags;
+    rec.ring = ch;
+
+    sreg = SREG;
+    cli();
+    // 2. The head record has all its bytes written and only waits for the
+    //    next EE_RDY to be dropped: drop it now, so a new store to its
+    //    channel goes to the next slot instead of over the finished one
+    if (channel_q_count && channel_q_byte >= sizeof(channel_rec_t)) {
+        channel_q_byte = 0;
+        channel_q_head = (channel_q_head + 1) % CHANNEL_QUEUE_LEN;
+        channel_q_count--;
+    }
+    // 3. Latest wins: a queued record of this channel is replaced, and
+    //    restarted from its first byte if it is being written
+    for (i = 0; i < channel_q_count; i++) {
+        channel_job_t *q = &channel_queue[(channel_q_head + i) % CHANNEL_QUEUE_LEN];
+        if (q->rec.ring == ch) {
+            job = q;
+            if (i == 0) channel_q_byte = 0;
+            break;
+        }
+    }
+    if (job) {
+        rec.seq = channel_seq[ch];
+    } else {
+        if (channel_q_count >= CHANNEL_QUEUE_LEN) {
+            SREG = sreg;
+            return false;
+        }
+        job = &channel_queue[(channel_q_head + channel_q_count) % CHANNEL_QUEUE_LEN];
+        channel_q_count++;
+        if (channel_slot[ch] == CHANNEL_NONE) {
+            channel_slot[ch] = 0;
+            rec.seq = 0;
+        } else {
+            channel_slot[ch] = (channel_slot[ch] + 1) % channel_ring_slots(ch);
+            rec.seq = channel_seq[ch] + 1;
+        }
+        job->addr = channel_addr(ch, channel_slot[ch]);
+    }
+    rec.check = channel_check(&rec);
+    job->rec = rec;
+
+    // 4. The index follows at once; EE_RDY fires as soon as the EEPROM is free
+    channel_seq[ch] = rec.seq;
+    channel_flags[ch] = flags;
+    channel_khz[ch] = khz;
+    EECR |= (1 << EERIE);
+    SREG = sreg;
+    return true;
+}
+
+/** \brief Post channel ch to the retune scheduler with its stored words
+ *
+ *  khz and output_on get the stored state. The words come from the write
+ *  queue when the record is still in it, and from the EEPROM when no byte
+ *  write is running; otherwise only the frequency is posted and the
+ *  scheduler solves it. False when the channel is empty.
+ */
+bool Channel_Recall(uint8_t ch, uint32_t *khz, bool *output_on)
+{
+    channel_rec_t rec;
+    bool have = false;
+    uint8_t sreg;
+    uint8_t i;
+
+    if (ch >= CHANNEL_RINGS || channel_slot[ch] == CHANNEL_NONE) return false;
+    *khz = channel_khz[ch];
+    *output_on = (channel_flags[ch] & CHANNEL_FLAG_ON) != 0;
+
+    sreg = SREG;
+    cli();
+    // 1. Still queued: the RAM copy is the newest
+    for (i = 0; i < channel_q_count && !have; i++) {
+        const channel_job_t *q = &channel_queue[(channel_q_head + i) % CHANNEL_QUEUE_LEN];
+        if (q->rec.ring == ch) {
+            rec = q->rec;
+            have = true;
+        }
+    }
+
+    // 2. EEPROM idle: hold the queue while the record is read
+    if (!have && !(EECR & (1 << EEWE))) {
+        EECR &= ~(1 << EERIE);
+        SREG = sreg;
+        eeprom_read_block(&rec, (const void *)(uintptr_t)channel_addr(ch, channel_slot[ch]), sizeof(rec));
+        have = channel_valid(&rec, ch);
+        cli();
+        if (channel_q_count) EECR |= (1 << EERIE);
+    }
+    SREG = sreg;
+
+    if (have) Retune_PostWords(*khz, &rec.words, *output_on);
+    else      Retune_Post(*khz, *output_on);
+    return true;
+}
+
+/** \brief Frequency stored in channel ch, 0 when empty */
+uint32_t Channel_KHz(uint8_t ch)
+{
+    if (ch >= CHANNEL_RINGS || channel_slot[ch] == CHANNEL_NONE) return 0;
+    return channel_khz[ch];
+}
+
+/** \brief True while records are waiting for the EEPROM */
+bool Channel_Busy(void)
+{
+    return channel_q_count != 0;
+}
+
+// EEPROM ready: start the next byte that differs, drop finished records
+ISR(EE_RDY_vect)
+{
+    while (channel_q_count) {
+        const channel_job_t *job = &channel_queue[channel_q_head];
+
+        if (channel_q_byte < sizeof(channel_rec_t)) {
+            uint8_t *addr = (uint8_t *)(uintptr_t)(job->addr + channel_q_byte);
+            uint8_t data = ((const uint8_t *)&job->rec)[channel_q_byte];
+
+            channel_q_byte++;
+            if (eeprom_read_byte(addr) != data) {
+                eeprom_write_byte(addr, data);
+                return;
+            }
+        } else {
+            channel_q_byte = 0;
+            channel_q_head = (channel_q_head + 1) % CHANNEL_QUEUE_LEN;
+            channel_q_count--;
+        }
+    }
+    EECR &= ~(1 << EERIE);
+}
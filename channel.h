@@ -0,0 +1,55 @@
+/**
+ * @file     channel.h
+ * @brief    Memory channels in EEPROM, stored with their solved words
+ * @date     16 October 2026
+ *
+ * Each channel keeps the frequency, the output state and the stateless
+ * R0/R1/R4 words the solver produced for it, so a recall is a register
+ * load (Retune_PostWords) instead of a solve. CHANNEL_LAST holds the
+ * last-used state that main.c restores at boot.
+ *
+ * Every channel is a ring of slots; a store goes to the slot after the
+ * newest one with the next sequence number, so writes spread over the ring
+ * and the previous record stays valid until the new one is complete (its
+ * check byte goes last). The last-used state is written far more often
+ * than a channel and gets the longest ring.
+ *
+ * Stores only queue the record. The EE_RDY interrupt writes it one byte
+ * per EEPROM write cycle (about 8.5 ms on the ATmega8A) and skips bytes
+ * that already hold the right value, so neither the UI nor a retune ever
+ * waits for the EEPROM. A recall while a write is in flight takes the
+ * record from the queue, or posts just the frequency for the solver.
+ */
+
+#ifndef CHANNEL_H_
+#define CHANNEL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "adf4351.h"
+
+#define CHANNEL_COUNT           10          // Channels 0-9, one per digit key
+#define CHANNEL_LAST            CHANNEL_COUNT
+#define CHANNEL_SLOTS           2           // Ring length of a channel
+#define CHANNEL_LAST_SLOTS      5           // Ring length of CHANNEL_LAST
+#define CHANNEL_QUEUE_LEN       2           // Records waiting for the EEPROM
+
+#define CHANNEL_FLAG_ON         0x01        // RF output on
+
+/** \brief One EEPROM record; 20 bytes, no padding on the AVR or the host */
+typedef struct {
+    uint32_t            khz;
+    ADF4351_FreqWords_t words;              // Stateless: R1 PhaseAdjust clear
+    uint8_t             seq;                // Newest slot of a ring has the highest
+    uint8_t             flags;              // CHANNEL_FLAG_*
+    uint8_t             ring;               // Channel number, guards the layout
+    uint8_t             check;              // Written last
+} channel_rec_t;
+
+void     Channel_Init(uint32_t refin_hz, uint32_t spacing_hz);
+bool     Channel_Store(uint8_t ch, uint32_t khz, bool output_on);
+bool     Channel_Recall(uint8_t ch, uint32_t *khz, bool *output_on);
+uint32_t Channel_KHz(uint8_t ch);
+bool     Channel_Busy(void);
+
+#endif /* CHANNEL_H_ */
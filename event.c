@@ -0,0 +1,81 @@
+/**
+ * @file     event.c
+ * @brief    ISR-to-main-loop event flags and the idle sleep between passes
+ * @date     16 October 2026
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "event.h"
+
+volatile uint8_t Event_Pending;
+event_stats_t    Event_Stats;
+
+static uint16_t event_mark;                 // TCNT1 at the start of the current pass
+
+/** \brief Select idle sleep and start the statistics; Timer1 must be running */
+void Event_Init(void)
+{
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    Event_ResetStats();
+}
+
+/** \brief Sleep until an event is pending, then return and clear all of them
+ *
+ *  Events are checked with interrupts off and SLEEP follows SEI directly,
+ *  so an ISR that posts between the check and the sleep still wakes it
+ *  (the AVR runs the instruction after SEI before any interrupt).
+ */
+uint8_t Event_Wait(void)
+{
+    uint8_t  events;
+    uint16_t now;
+
+    cli();
+    now = TCNT1;
+    Event_Stats.busy_ticks += (uint16_t)(now - event_mark);
+    while (!(events = Event_Pending)) {
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+        cli();
+        Event_Stats.idle_ticks += (uint16_t)(TCNT1 - now);
+        Event_Stats.wakes++;
+        now = TCNT1;
+    }
+    Event_Pending = 0;
+    event_mark = now;
+    Event_Stats.passes++;
+    sei();
+    return events;
+}
+
+void Event_ResetStats(void)
+{
+    uint8_t sreg = SREG;
+
+    cli();
+    Event_Stats.busy_ticks = 0;
+    Event_Stats.idle_ticks = 0;
+    Event_Stats.wakes = 0;
+    Event_Stats.passes = 0;
+    event_mark = TCNT1;
+    SREG = sreg;
+}
+
+/** \brief Share of the time since the last reset spent asleep, 0-1000 */
+uint16_t Event_IdlePermille(void)
+{
+    uint32_t idle, total;
+    uint8_t  sreg = SREG;
+
+    cli();
+    idle = Event_Stats.idle_ticks;
+    total = idle + Event_Stats.busy_ticks;
+    SREG = sreg;
+    // Scaled down first so the product stays within 32 bits
+    while (total > 0x3FFFFFUL) { total >>= 1; idle >>= 1; }
+    return total ? (uint16_t)(idle * 1000UL / total) : 0;
+}
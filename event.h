@@ -0,0 +1,51 @@
+/**
+ * @file     event.h
+ * @brief    ISR-to-main-loop event flags and the idle sleep between passes
+ * @date     16 October 2026
+ *
+ * ISRs that leave work for the main loop post an EVENT_* bit with
+ * EVENT_POST(). Event_Wait() sleeps in SLEEP_MODE_IDLE until at least one
+ * bit is set and returns all of them at once, so one pass handles every
+ * source that became ready while the CPU slept. Timers, the USART, the
+ * ADC and the EEPROM keep running in idle mode.
+ *
+ * Event_Stats splits the time since Event_Init() (or the last
+ * Event_ResetStats()) into main loop passes and sleep, in Timer1 ticks of
+ * 8 CPU cycles. ISRs that run during a pass count as busy; the ISR that
+ * ends a sleep counts as idle. Passes or sleeps over 47 ms would wrap.
+ */
+
+#ifndef EVENT_H_
+#define EVENT_H_
+
+#include <stdint.h>
+
+#define EVENT_ROTARY    0x01        // Encoder moved a whole detent (Timer0)
+#define EVENT_KEY       0x02        // Key press or long press (ADC)
+#define EVENT_UART      0x04        // Byte received
+#define EVENT_SWEEP     0x08        // Sweep or hop step written, stage free
+#define EVENT_LCD       0x10        // Display queue drained and holdoff over
+#define EVENT_TICK      0x20        // Slow housekeeping tick (Timer0)
+
+// Timer0 overflows per EVENT_TICK: ~95 ms, timers in the main loop count g_ticks
+#define EVENT_TICK_DIV  64
+
+/** \brief Post from ISR context only; ISRs do not nest, so |= is atomic there */
+#define EVENT_POST(e)   (Event_Pending |= (e))
+
+typedef struct {
+    uint32_t busy_ticks;        // Main loop passes, with the ISRs inside them
+    uint32_t idle_ticks;        // Asleep, with the ISRs that woke the CPU
+    uint32_t wakes;             // Interrupts that ended a sleep
+    uint32_t passes;            // Event_Wait() returns
+} event_stats_t;
+
+extern volatile uint8_t Event_Pending;
+extern event_stats_t    Event_Stats;
+
+void     Event_Init(void);
+uint8_t  Event_Wait(void);
+void     Event_ResetStats(void);
+uint16_t Event_IdlePermille(void);
+
+#endif /* EVENT_H_ */
@@ -0,0 +1,212 @@
+/**
+ * @file     hop.c
+ * @brief    Frequency hopping over a precomputed register list
+ * @date     16 October 2026
+ */
+
+#ifndef F_CPU
+#define F_CPU 11059200UL
+#endif
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "hop.h"
+#include "sweep.h"
+#include "adf4351.h"
+#include "event.h"
+
+// R1 and R4 are solved from the same base with the same MOD for every
+// entry, so only R0 and the R4 output divider are kept per entry
+typedef struct {
+    uint32_t            r0;
+    uint8_t             mask;       // Words that differ from the previous entry
+    uint8_t             rf_div;     // R4 RfDivSel
+} hop_entry_t;
+
+static hop_entry_t      hop_entries[HOP_LIST_MAX];
+static uint32_t         hop_r1;
+static uint32_t         hop_r4;     // Output divider of entry 0
+static const uint32_t  *hop_list_khz;
+static uint8_t          hop_count;
+static hop_trigger_t    hop_trigger;
+static uint32_t         hop_period_ticks;
+
+static volatile bool     hop_running;
+static volatile uint8_t  hop_index;         // Entry on the output
+static volatile uint32_t hop_left;          // Ticks still to wait before the next hop
+
+volatile uint16_t Hop_LatencyLast;
+volatile uint16_t Hop_LatencyMax;
+
+// Load the changed words of the next entry and latch them (ISR context)
+static void hop_step(void)
+{
+    const hop_entry_t *e;
+    uint8_t index = hop_index + 1;
+
+    if (index >= hop_count) index = 0;
+    e = &hop_entries[index];
+    if (e->mask & SWEEP_TABLE_R4) ADF4351_Reg4.b.RfDivSel = e->rf_div;
+    if (e->mask & SWEEP_TABLE_R0) ADF4351_Reg0.w = e->r0;
+    ADF4351_CommitRegisters();
+    hop_index = index;
+    EVENT_POST(EVENT_SWEEP);
+}
+
+static void hop_record(uint16_t ticks)
+{
+    Hop_LatencyLast = ticks;
+    if (ticks > Hop_LatencyMax) Hop_LatencyMax = ticks;
+}
+
+static void hop_schedule(void)
+{
+    uint16_t chunk = (hop_left > 0xFFFFUL) ? 0x8000U : (uint16_t)hop_left;
+
+    hop_left -= chunk;
+    OCR1B += chunk;
+}
+
+/** \brief Solve a list into register words; the list must stay valid while hopping
+ *
+ *  R1/R4 are based on the current shadows, so the RF output enable and
+ *  power settings are taken as they are now. Fails on an entry outside
+ *  ADF4351_RFOUTMIN..ADF4351_RFOUT_MAX.
+ */
+bool Hop_Load(const uint32_t *list_khz, uint8_t count, uint32_t refin_hz, uint32_t spacing_hz)
+{
+    ADF4351_FreqWords_t words;
+    ADF4351_Reg4_t r4;
+    ADF4351_ERR_t err;
+    uint8_t i;
+
+    if (count == 0 || count > HOP_LIST_MAX) return false;
+    Hop_Stop();
+    hop_count = 0;
+
+    for (i = 0; i < count; i++) {
+        if (list_khz[i] < ADF4351_RFOUTMIN || list_khz[i] > ADF4351_RFOUT_MAX) return false;
+        words.r1 = ADF4351_Reg1.w;
+        words.r4 = ADF4351_Reg4.w;
+        err = ADF4351_CalcFrequencyWords(list_khz[i], refin_hz, spacing_hz, 0, &words, 0);
+        if (err != ADF4351_Err_None && err != ADF4351_Warn_NotTuned) return false;
+        r4.w = words.r4;
+        hop_entries[i].r0 = words.r0;
+        hop_entries[i].rf_div = r4.b.RfDivSel;
+        if (i == 0) {
+            hop_r1 = words.r1;
+            hop_r4 = words.r4;
+        }
+    }
+
+    // Masks against the entry before, the last entry wraps to the first
+    for (i = 0; i < count; i++) {
+        const hop_entry_t *prev = &hop_entries[i ? i - 1 : count - 1];
+        const hop_entry_t *cur = &hop_entries[i];
+        uint8_t mask = 0;
+        if (cur->r0 != prev->r0) mask |= SWEEP_TABLE_R0;
+        if (cur->rf_div != prev->rf_div) mask |= SWEEP_TABLE_R4;
+        hop_entries[i].mask = mask;
+    }
+
+    hop_list_khz = list_khz;
+    hop_count = count;
+    return true;
+}
+
+/** \brief Output entry 0 and start hopping on the selected trigger */
+bool Hop_Start(hop_trigger_t trigger, uint32_t period_us)
+{
+    if (hop_count == 0) return false;
+    Hop_Stop();
+
+    if (period_us < HOP_MIN_PERIOD_US) period_us = HOP_MIN_PERIOD_US;
+    hop_period_ticks = (uint32_t)(((uint64_t)period_us * SWEEP_TIMER_HZ) / 1000000UL);
+    hop_trigger = trigger;
+
+    // 1. Entry 0 goes out in full from here, the triggers step from it
+    ADF4351_Reg0.w = hop_entries[0].r0;
+    ADF4351_Reg1.w = hop_r1;
+    ADF4351_Reg4.w = hop_r4;
+    ADF4351_CommitRegisters();
+    hop_index = 0;
+    Hop_LatencyLast = 0;
+    Hop_LatencyMax = 0;
+
+    // 2. Arm the trigger
+    cli();
+    switch (trigger) {
+    case HOP_TRIG_TIMER:
+        hop_left = hop_period_ticks;
+        OCR1B = TCNT1;
+        hop_schedule();
+        TIFR = (1 << OCF1B);
+        TIMSK |= (1 << OCIE1B);
+        break;
+    case HOP_TRIG_INT0:
+        DDRD &= ~(1 << PD2);
+        MCUCR |= (1 << ISC01) | (1 << ISC00);
+        GIFR = (1 << INTF0);
+        GICR |= (1 << INT0);
+        break;
+    case HOP_TRIG_INT1:
+        DDRD &= ~(1 << PD3);
+        MCUCR |= (1 << ISC11) | (1 << ISC10);
+        GIFR = (1 << INTF1);
+        GICR |= (1 << INT1);
+        break;
+    }
+    hop_running = true;
+    sei();
+    return true;
+}
+
+void Hop_Stop(void)
+{
+    cli();
+    TIMSK &= ~(1 << OCIE1B);
+    GICR &= ~((1 << INT0) | (1 << INT1));
+    hop_running = false;
+    sei();
+}
+
+bool Hop_Running(void)
+{
+    return hop_running;
+}
+
+/** \brief Frequency of the entry currently on the output */
+uint32_t Hop_CurrentKHz(void)
+{
+    return hop_count ? hop_list_khz[hop_index] : 0;
+}
+
+// Timer1 Compare B: one hop per period
+ISR(TIMER1_COMPB_vect)
+{
+    uint16_t due = OCR1B;
+
+    if (hop_left) { hop_schedule(); return; }
+
+    hop_left = hop_period_ticks;
+    hop_schedule();
+    hop_step();
+    hop_record(TCNT1 - due);
+}
+
+// External triggers: one hop per rising edge
+ISR(INT0_vect)
+{
+    uint16_t entry = TCNT1;
+
+    hop_step();
+    hop_record(TCNT1 - entry);
+}
+
+ISR(INT1_vect)
+{
+    uint16_t entry = TCNT1;
+
+    hop_step();
+    hop_record(TCNT1 - entry);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file     hop.h
+ * @brief    Frequency hopping over a precomputed register list
+ * @date     16 October 2026
+ *
+ * Hop_Load() runs the solver once per entry, in the main loop, and keeps
+ * R0 and the R4 output divider of each entry in RAM (R1 is the same for
+ * the whole list) together with a mask of the words that differ from the
+ * previous entry (SWEEP_TABLE_Rn bits). A hop then only loads those
+ * words and commits, so its cost does not depend on the frequency. Hops
+ * are triggered by Timer1 OCR1B or by a rising edge on INT0 (PD2) /
+ * INT1 (PD3).
+ *
+ * Every hop records its latency in Timer1 ticks (SWEEP_TIMER_HZ). For the
+ * timer trigger it runs from the compare match to the LE latch of the last
+ * word, so it includes time spent waiting for other ISRs. For the external
+ * triggers it runs from ISR entry to the latch; add the interrupt response
+ * (4 cycles) and the longest ISR that can be running when the edge arrives.
+ *
+ * Like a sweep, a running hop list owns the ADF4351 shadows.
+ */
+
+#ifndef HOP_H_
+#define HOP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef PROFILE_ENABLE                   // Room for the statistics (profile.h)
+#define HOP_LIST_MAX            4
+#else
+#define HOP_LIST_MAX            8
+#endif
+#define HOP_MIN_PERIOD_US       100UL
+
+// Timer1 ticks to ns at SWEEP_TIMER_HZ
+#define HOP_TICKS_TO_NS(t)      ((uint32_t)(((uint64_t)(t) * 8000000000ULL) / F_CPU))
+
+typedef enum {
+    HOP_TRIG_TIMER,
+    HOP_TRIG_INT0,
+    HOP_TRIG_INT1
+} hop_trigger_t;
+
+extern volatile uint16_t Hop_LatencyLast;   // Ticks, last hop
+extern volatile uint16_t Hop_LatencyMax;    // Ticks, worst hop since Hop_Start()
+
+bool     Hop_Load(const uint32_t *list_khz, uint8_t count, uint32_t refin_hz, uint32_t spacing_hz);
+bool     Hop_Start(hop_trigger_t trigger, uint32_t period_us);
+void     Hop_Stop(void);
+bool     Hop_Running(void);
+uint32_t Hop_CurrentKHz(void);
+
+#endif /* HOP_H_ */
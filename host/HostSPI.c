@@ -0,0 +1,133 @@
+/**
+ * @file     HostSPI.c
+ * @brief    Linux SPI backend that records ADF4351 traffic
+ * @date     16 October 2026
+ */
+
+#include "HostSPI.h"
+
+static uint32_t host_spi_bit_ns   = HOST_SPI_BIT_NS_DEFAULT;
+static uint32_t host_spi_latch_ns = HOST_SPI_LATCH_NS_DEFAULT;
+
+static uint32_t host_spi_shift;         // ADF4351 input shift register
+static uint8_t  host_spi_selected;      // LE low
+static uint32_t host_spi_log[HOST_SPI_LOG_SIZE];
+static uint8_t  host_spi_log_lane[HOST_SPI_LOG_SIZE];
+static uint32_t host_spi_words;
+static uint64_t host_spi_edges;
+static uint64_t host_spi_time_ns;
+static uint64_t host_spi_word_start_ns; // Bus time at the LE falling edge
+static void   (*host_spi_latch_hook)(uint32_t word, uint32_t bus_ns);
+
+static void host_spi_record(uint32_t word, uint8_t lane, uint32_t bus_ns) {
+    if (host_spi_words < HOST_SPI_LOG_SIZE) {
+        host_spi_log[host_spi_words] = word;
+        host_spi_log_lane[host_spi_words] = lane;
+    }
+    host_spi_words++;
+    if (host_spi_latch_hook) host_spi_latch_hook(word, bus_ns);
+}
+
+static void host_spi_init(void) {
+    host_spi_selected = 0;
+}
+
+static void host_spi_chip_enable(void) {
+    host_spi_selected = 1;
+    host_spi_word_start_ns = host_spi_time_ns;
+    host_spi_time_ns += host_spi_latch_ns;
+}
+
+static void host_spi_transfer(uint8_t data) {
+    // The chip clocks in on SCLK rising edges whatever LE is doing, MSB first
+    host_spi_shift = (host_spi_shift << 8) | data;
+    host_spi_edges += 16;
+    host_spi_time_ns += 8UL * host_spi_bit_ns;
+}
+
+static void host_spi_chip_disable(void) {
+    if (!host_spi_selected) return;
+    host_spi_selected = 0;
+    host_spi_time_ns += host_spi_latch_ns;
+
+    // LE rising edge: the last 32 bits go to the register picked by C3:C1
+    host_spi_record(host_spi_shift, 0, (uint32_t)(host_spi_time_ns - host_spi_word_start_ns));
+}
+
+static void host_spi_write32(uint32_t word) {
+    host_spi_chip_enable();
+    host_spi_transfer((uint8_t)(word >> 24));
+    host_spi_transfer((uint8_t)(word >> 16));
+    host_spi_transfer((uint8_t)(word >> 8));
+    host_spi_transfer((uint8_t)word);
+    host_spi_chip_disable();
+}
+
+const spi_transport_t host_spi_transport = {
+    host_spi_init,
+    host_spi_chip_enable,
+    host_spi_transfer,
+    host_spi_chip_disable,
+    host_spi_write32,
+    0                       // No PLL behind the recorder; host/sim models the LD pin
+};
+
+// All lanes in the mask shift together and latch on one edge: one word of
+// bus time, every lane's word logged in lane order
+static void host_spi_bus_write32(const uint32_t *words, uint8_t lane_mask) {
+    uint64_t start = host_spi_time_ns;
+    uint8_t i;
+
+    host_spi_time_ns += 2UL * host_spi_latch_ns + 32UL * host_spi_bit_ns;
+    host_spi_edges += 64;
+    for (i = 0; i < HOST_SPI_LANES; i++) {
+        if (!(lane_mask & (1 << i))) continue;
+        host_spi_record(words[i], i, (uint32_t)(host_spi_time_ns - start));
+        start = host_spi_time_ns;           // The rest latch in the same instant
+    }
+}
+
+const spi_bus_t host_spi_bus = {
+    HOST_SPI_LANES,
+    host_spi_bus_write32,
+    0                       // Every lane has its own LE
+};
+
+void host_spi_reset(void) {
+    host_spi_shift = 0;
+    host_spi_selected = 0;
+    host_spi_words = 0;
+    host_spi_edges = 0;
+    host_spi_time_ns = 0;
+}
+
+void host_spi_set_timing(uint32_t bit_ns, uint32_t latch_ns) {
+    host_spi_bit_ns = bit_ns;
+    host_spi_latch_ns = latch_ns;
+}
+
+// Called after every latch with the word and the bus time it took;
+// host/sim uses it to move its virtual clock
+void host_spi_set_latch_hook(void (*hook)(uint32_t word, uint32_t bus_ns)) {
+    host_spi_latch_hook = hook;
+}
+
+uint32_t host_spi_word_count(void) {
+    return host_spi_words;
+}
+
+uint32_t host_spi_word(uint32_t index) {
+    return (index < HOST_SPI_LOG_SIZE) ? host_spi_log[index] : 0;
+}
+
+uint8_t host_spi_word_lane(uint32_t index) {
+    return (index < HOST_SPI_LOG_SIZE) ? host_spi_log_lane[index] : 0;
+}
+
+uint64_t host_spi_clock_edges(void) {
+    return host_spi_edges;
+}
+
+uint64_t host_spi_bus_time_ns(void) {
+    return host_spi_time_ns;
+}
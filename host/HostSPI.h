@@ -0,0 +1,45 @@
+/**
+ * @file     HostSPI.h
+ * @brief    Linux SPI backend that records ADF4351 traffic
+ * @date     16 October 2026
+ *
+ * Stands in for SoftwareSPI on the host. Every word latched on the LE
+ * rising edge is recorded, together with the number of SCLK edges and the
+ * bus time the AVR bit-bang would have taken. host_spi_bus does the same
+ * for a bit-parallel bus and logs the lane of every word. Build with the
+ * driver, e.g.
+ *
+ *   gcc -I. -Ihost adf4351.c host/HostSPI.c your_program.c
+ */
+
+#ifndef HOSTSPI_H_
+#define HOSTSPI_H_
+
+#include <stdint.h>
+#include "spi_transport.h"
+
+// Default timing model: soft_spi_write32() at 11.0592 MHz,
+// ~6 cycles per bit and ~4 cycles around each LE edge
+#define HOST_SPI_BIT_NS_DEFAULT     543UL
+#define HOST_SPI_LATCH_NS_DEFAULT   362UL
+
+// Number of latched words kept for inspection (counting continues past it)
+#define HOST_SPI_LOG_SIZE           4096
+
+// Lanes on host_spi_bus, each with its own LE
+#define HOST_SPI_LANES              8
+
+extern const spi_transport_t host_spi_transport;
+extern const spi_bus_t       host_spi_bus;
+
+void     host_spi_reset(void);
+void     host_spi_set_timing(uint32_t bit_ns, uint32_t latch_ns);
+void     host_spi_set_latch_hook(void (*hook)(uint32_t word, uint32_t bus_ns));
+
+uint32_t host_spi_word_count(void);
+uint32_t host_spi_word(uint32_t index);
+uint8_t  host_spi_word_lane(uint32_t index);       // 0 for words from host_spi_transport
+uint64_t host_spi_clock_edges(void);
+uint64_t host_spi_bus_time_ns(void);
+
+#endif /* HOSTSPI_H_ */
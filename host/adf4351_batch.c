@@ -0,0 +1,212 @@
+/**
+ * @file     adf4351_batch.c
+ * @brief    Batch ADF4351 solver for host-side planning tools
+ * @date     16 October 2026
+ */
+
+#include <string.h>
+#include "adf4351_batch.h"
+
+// One lane per point: the double vector is a whole AVX or SSE2 register
+typedef double   vdf __attribute__((vector_size(8 * ADF4351_BATCH_LANES)));
+typedef int64_t  vdi __attribute__((vector_size(8 * ADF4351_BATCH_LANES)));
+typedef uint32_t vsu __attribute__((vector_size(4 * ADF4351_BATCH_LANES)));
+typedef int32_t  vsi __attribute__((vector_size(4 * ADF4351_BATCH_LANES)));
+typedef uint16_t vhu __attribute__((vector_size(2 * ADF4351_BATCH_LANES)));
+typedef uint8_t  vqu __attribute__((vector_size(ADF4351_BATCH_LANES)));
+
+// x + M - M rounds x to an integer for |x| < 2^51
+#define BATCH_ROUND_MAGIC   6755399441055744.0      // 1.5 * 2^52
+
+// Macros rather than functions: vector arguments would change the calling
+// convention between builds with and without -mavx
+
+// Lanes of m all ones: a, otherwise b
+#define BATCH_SEL(m, a, b)  ((vdf)(((vdi)(a) & (m)) | ((vdi)(b) & ~(m))))
+
+// q = floor(num / den) and r the remainder, for integers 0 <= num < 2^53 and
+// num / den < 2^51; den and inv (1 / den) are scalars. The rounded product
+// is at most one off, the exact remainder says which way.
+#define BATCH_DIVMOD(q, r, num, den, inv) do { \
+    vdi m_; \
+    q = ((num) * (inv) + BATCH_ROUND_MAGIC) - BATCH_ROUND_MAGIC; \
+    r = (num) - q * (den); \
+    m_ = r < 0.0; \
+    q = BATCH_SEL(m_, q - 1.0, q); \
+    r = BATCH_SEL(m_, r + (den), r); \
+    m_ = r >= (den); \
+    q = BATCH_SEL(m_, q + 1.0, q); \
+    r = BATCH_SEL(m_, r - (den), r); \
+} while (0)
+
+// Output divider thresholds in kHz, as ADF4351_Select_Output_Divider()
+static const double batch_div_khz[ADF4351_RFDIV_64] = {
+    2200000.0, 1100000.0, 550000.0, 275000.0, 137500.0, 68750.0
+};
+
+// Reference setup shared by every point of a batch
+typedef struct {
+    double   pfd_num;                   // PFD = pfd_num / pfd_den Hz, as the scalar solver
+    double   pfd_den;
+    double   inv_pfd_num;
+    double   inv_pfd_num2;              // 1 / (2 * pfd_num)
+    double   mod0;                      // MOD before the MOD 1 -> 2 fix, used for FRAC
+    double   mod;
+    double   hz_per_step;               // PFD / MOD: RFout = (INT * MOD + FRAC) * hz_per_step / div
+    ADF4351_Dev_t dev;                  // Reg2 only, for the scalar tie fallback
+    uint32_t refin_hz;
+    uint32_t spacing_hz;
+} batch_ref_t;
+
+// One exact FRAC rounding tie, through the scalar solver
+static void batch_scalar(const batch_ref_t *ref, uint32_t khz, double *INT, double *FRAC, double *rfout)
+{
+    ADF4351_FreqWords_t w;
+    ADF4351_Freq_t      f;
+    ADF4351_Reg0_t      r0;
+
+    w.r1 = ADF4351_GOLDEN_R1;
+    w.r4 = ADF4351_GOLDEN_R4;
+    ADF4351_DevCalcFrequencyWords(&ref->dev, khz, ref->refin_hz, ref->spacing_hz, 0, &w, &f);
+    r0.w = w.r0;
+    *INT = r0.b.IntVal;
+    *FRAC = r0.b.FracVal;
+    *rfout = (double)f.Num / f.Den;
+}
+
+// Store the first n lanes of a vector; whole vectors take the fixed-size path
+#define BATCH_STORE(dst, v, n) do { \
+    if ((n) == ADF4351_BATCH_LANES) memcpy((dst), &(v), sizeof(v)); \
+    else memcpy((dst), &(v), (n) * (sizeof(v) / ADF4351_BATCH_LANES)); \
+} while (0)
+
+// Points khz[0..n-1], n <= ADF4351_BATCH_LANES, into Out at index j; khz
+// must have ADF4351_BATCH_LANES readable entries
+static inline __attribute__((always_inline))
+void batch_kernel(const batch_ref_t *ref, const uint32_t *khz, size_t j, size_t n,
+                  const ADF4351_Batch_t *Out)
+{
+    vsu k32;
+    vdf k, odiv, nnum, nrem, fnum, frac, r2, INT, FRAC, rfout;
+    vdi div, carry, tie, low, high, badn, status;
+    uint8_t d;
+
+    // 1. Output divider: count the thresholds above RFout
+    memcpy(&k32, khz, sizeof(k32));
+    k = __builtin_convertvector((vsi)k32, vdf);
+    k = BATCH_SEL(k < 0.0, k + 4294967296.0, k);
+    odiv = (vdf){ 0 } + 1.0;
+    div = (vdi){ 0 };
+    for (d = 0; d < ADF4351_RFDIV_64; d++) {
+        vdi below = k < batch_div_khz[d];
+        odiv = BATCH_SEL(below, odiv * 2.0, odiv);
+        div -= below;
+    }
+
+    // 2. N = NNum / PFDNum, FRAC rounded half up; FRAC == MOD carries into INT
+    nnum = k * 1000.0 * odiv * ref->pfd_den;
+    BATCH_DIVMOD(INT, nrem, nnum, ref->pfd_num, ref->inv_pfd_num);
+    fnum = nrem * (ref->mod0 * 2.0) + ref->pfd_num;
+    BATCH_DIVMOD(frac, r2, fnum, ref->pfd_num * 2.0, ref->inv_pfd_num2);
+    tie = r2 == 0.0;
+    carry = frac >= ref->mod0;
+    INT = BATCH_SEL(carry, INT + 1.0, INT);
+    FRAC = BATCH_SEL(carry, frac - ref->mod0, frac);
+
+    // 3. RFout = (INT + FRAC / MOD) * PFD / OutputDivider; odiv is a power of two
+    rfout = (INT * ref->mod + FRAC) * ref->hz_per_step / odiv;
+
+    // 4. Ties are rare (about 1 point in 100 at 1 kHz steps): scalar solve
+    for (d = 0; d < n; d++) {
+        double i_, f_, r_;
+        if (!tie[d]) continue;
+        batch_scalar(ref, khz[d], &i_, &f_, &r_);
+        INT[d] = i_;
+        FRAC[d] = f_;
+        rfout[d] = r_;
+    }
+
+    // 5. Range status, first failing check wins
+    low = k < (double)ADF4351_RFOUTMIN;
+    high = k > (double)ADF4351_RFOUT_MAX;
+    badn = (INT < 75.0) | (INT > 65535.0);
+    status = (low & ADF4351_Err_RFoutTooLow) |
+             (~low & high & ADF4351_Err_RFoutTooHigh) |
+             (~low & ~high & badn & ADF4351_Err_InvalidN);
+
+    // 6. Narrow and store the requested arrays
+    if (Out->Int) {
+        vhu v = __builtin_convertvector(__builtin_convertvector(INT, vsi), vhu);
+        BATCH_STORE(&Out->Int[j], v, n);
+    }
+    if (Out->Frac) {
+        vhu v = __builtin_convertvector(__builtin_convertvector(FRAC, vsi), vhu);
+        BATCH_STORE(&Out->Frac[j], v, n);
+    }
+    if (Out->Mod) {
+        vhu v = (vhu){ 0 } + (uint16_t)ref->mod;
+        BATCH_STORE(&Out->Mod[j], v, n);
+    }
+    if (Out->RfDivSel) {
+        vqu v = __builtin_convertvector(div, vqu);
+        BATCH_STORE(&Out->RfDivSel[j], v, n);
+    }
+    if (Out->RFoutHz) BATCH_STORE(&Out->RFoutHz[j], rfout, n);
+    if (Out->ErrHz) {
+        vdf v = rfout - k * 1000.0;
+        BATCH_STORE(&Out->ErrHz[j], v, n);
+    }
+    if (Out->Status) {
+        vqu v = __builtin_convertvector(status, vqu);
+        BATCH_STORE(&Out->Status[j], v, n);
+    }
+}
+
+/** \brief Solve Count frequencies for the reference setup in R2
+ *
+ *  REFinHz and OutputChannelSpacingHz are in Hz, as for the scalar solver.
+ *  Setup errors (REFin, R counter, PFD, MOD) are returned for the whole
+ *  batch and nothing is written; per-point results go to Out->Status.
+ */
+ADF4351_ERR_t ADF4351_BatchSolve(const uint32_t *RFoutKHz, size_t Count, uint32_t R2, uint32_t REFinHz,
+                                 uint32_t OutputChannelSpacingHz, const ADF4351_Batch_t *Out)
+{
+    batch_ref_t ref;
+    uint32_t    pfd_num;
+    uint16_t    pfd_den;
+    uint64_t    D;
+    size_t      i;
+
+    // 1. Reference setup, the same integers as ADF4351_DevCalcFrequencyWords()
+    memset(&ref, 0, sizeof(ref));
+    ref.dev.Reg2.w = R2;
+    if (REFinHz > ADF4351_REFINMAX) return ADF4351_Err_REFinTooHigh;
+    if (ref.dev.Reg2.b.RCountVal == 0) return ADF4351_Err_PFD;
+    pfd_num = REFinHz * (ref.dev.Reg2.b.RMul2 + 1);
+    pfd_den = (uint16_t)(ref.dev.Reg2.b.RDiv2 + 1) * ref.dev.Reg2.b.RCountVal;
+    if (pfd_num > (uint64_t)ADF5451_PFD_MAX * pfd_den) return ADF4351_Err_PFD;
+    if (OutputChannelSpacingHz == 0) return ADF4351_Err_InvalidMOD;
+    D = (uint64_t)pfd_den * OutputChannelSpacingHz;
+    ref.mod0 = (double)(((uint64_t)pfd_num * 2 + D) / (D * 2));
+    if (ref.mod0 > 4095) return ADF4351_Err_InvalidMOD;
+    ref.mod = (ref.mod0 == 1) ? 2 : ref.mod0;
+    ref.pfd_num = pfd_num;
+    ref.pfd_den = pfd_den;
+    ref.inv_pfd_num = 1.0 / ref.pfd_num;
+    ref.inv_pfd_num2 = 0.5 / ref.pfd_num;
+    ref.hz_per_step = ref.pfd_num / (ref.pfd_den * ref.mod);
+    ref.refin_hz = REFinHz;
+    ref.spacing_hz = OutputChannelSpacingHz;
+
+    // 2. Whole vectors, then the tail padded with its first point
+    for (i = 0; i + ADF4351_BATCH_LANES <= Count; i += ADF4351_BATCH_LANES) {
+        batch_kernel(&ref, &RFoutKHz[i], i, ADF4351_BATCH_LANES, Out);
+    }
+    if (i < Count) {
+        uint32_t pad[ADF4351_BATCH_LANES];
+        size_t   n = Count - i, l;
+        for (l = 0; l < ADF4351_BATCH_LANES; l++) pad[l] = RFoutKHz[i + (l < n ? l : 0)];
+        batch_kernel(&ref, pad, i, n, Out);
+    }
+    return ADF4351_Err_None;
+}
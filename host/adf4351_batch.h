@@ -0,0 +1,54 @@
+/**
+ * @file     adf4351_batch.h
+ * @brief    Batch ADF4351 solver for host-side planning tools
+ * @date     16 October 2026
+ *
+ * Solves a whole array of frequencies for one reference setup and writes
+ * struct-of-arrays results, ADF4351_BATCH_LANES points per SIMD step. The
+ * results are the same as ADF4351_DevCalcFrequencyWords() with gcd off,
+ * which is how the firmware runs it. The solver has no global state, so
+ * several threads may each solve their own slice of a plan.
+ *
+ * The kernel works in double lanes (GCC vector extensions). Every quotient
+ * is corrected against an exact remainder, so the rounding matches the
+ * integer solver. The rare exact FRAC rounding tie goes to the scalar
+ * solver for that point.
+ *
+ * Per point, Status also reports an RFout outside 35 MHz - 4.4 GHz
+ * (ADF4351_Err_RFoutTooLow / TooHigh) and an INT outside 75-65535 for the
+ * 8/9 prescaler (ADF4351_Err_InvalidN). The scalar solver leaves those
+ * checks to ADF4351_CheckWords(). The other outputs are still filled for
+ * such points.
+ *
+ * Host only; host/batchbench.c builds it and compares it with the scalar path.
+ */
+
+#ifndef ADF4351_BATCH_H_
+#define ADF4351_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "adf4351.h"
+
+// Points per vector step: one double lane each, as wide as the target's registers
+#ifdef __AVX__
+#define ADF4351_BATCH_LANES     4
+#else
+#define ADF4351_BATCH_LANES     2
+#endif
+
+/** \brief Output arrays, Count entries each; a NULL array is not written */
+typedef struct {
+    uint16_t *Int;
+    uint16_t *Frac;
+    uint16_t *Mod;
+    uint8_t  *RfDivSel;                 // ADF4351_RFDIV_t
+    double   *RFoutHz;                  // Achieved output frequency
+    double   *ErrHz;                    // Achieved minus requested
+    uint8_t  *Status;                   // ADF4351_ERR_t
+} ADF4351_Batch_t;
+
+ADF4351_ERR_t ADF4351_BatchSolve(const uint32_t *RFoutKHz, size_t Count, uint32_t R2, uint32_t REFinHz,
+                                 uint32_t OutputChannelSpacingHz, const ADF4351_Batch_t *Out);
+
+#endif /* ADF4351_BATCH_H_ */
@@ -0,0 +1,175 @@
+/**
+ * @file     baselinecheck.c
+ * @brief    Integer solver against the original double-precision solver
+ * @date     16 October 2026
+ *
+ * baseline_solve() is the double-precision ADF4351_UpdateFrequencyRegisters()
+ * the driver shipped with (PFD, output divider, N, then INT/MOD/FRAC with
+ * round()). It works on locals instead of the register shadows. For every
+ * 1 kHz point from MIN_FREQ_KHZ to MAX_FREQ_KHZ and several reference
+ * setups, it checks that ADF4351_DevCalcFrequencyWords() gives the same
+ * INT, FRAC, MOD and RfDivSel.
+ *
+ * Both sides then apply the same fix-ups after rounding. A FRAC rounded
+ * up to MOD carries into INT, then the GCD step runs, then MOD 1 becomes
+ * MOD 2 with FRAC doubled. The original code ran the GCD step first and
+ * had no carry, so it could write FRAC == MOD or drift by half a step.
+ * Those points are counted and printed, not failed. Exits non-zero on
+ * any mismatch:
+ *
+ *   gcc -O2 -I. -o baselinecheck host/baselinecheck.c adf4351.c -lm
+ *   ./baselinecheck
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "adf4351.h"
+
+#define MIN_FREQ_KHZ    35000UL             // Same range as main.c
+#define MAX_FREQ_KHZ    4400000UL
+#define CHECK_SHOW      5                   // Mismatches printed per setup
+
+typedef struct {
+    const char *name;
+    uint32_t    refin_hz;
+    uint32_t    spacing_hz;
+    uint16_t    r_count;
+    uint8_t     doubler;
+    uint8_t     div2;
+    uint8_t     gcd;
+} check_config_t;
+
+static const check_config_t configs[] = {
+    { "25 MHz ref, 100 kHz spacing (firmware)", 25000000UL, 100000UL, 1, 0, 0, 0 },
+    { "25 MHz ref, 10 kHz spacing",             25000000UL,  10000UL, 1, 0, 0, 0 },
+    { "10 MHz ref x2, 10 kHz spacing",          10000000UL,  10000UL, 1, 1, 0, 0 },
+    { "100 MHz ref /4, 25 kHz spacing",        100000000UL,  25000UL, 4, 0, 0, 0 },
+    { "26 MHz ref /2 R=1, 6.25 kHz spacing",    26000000UL,   6250UL, 1, 0, 1, 0 },
+    { "25 MHz ref, 100 kHz spacing, gcd",       25000000UL, 100000UL, 1, 0, 0, 1 },
+    { "26 MHz ref /2 R=1, 6.25 kHz, gcd",       26000000UL,   6250UL, 1, 0, 1, 1 },
+};
+
+typedef struct {
+    uint16_t INT, FRAC, MOD;
+    uint8_t  RfDivSel;
+} words_t;
+
+static uint32_t gcd_u32(uint32_t a, uint32_t b)
+{
+    while (b) { uint32_t t = a % b; a = b; b = t; }
+    return a;
+}
+
+// The original output divider choice, on RFout in Hz
+static ADF4351_RFDIV_t baseline_divider(double RFoutFrequency)
+{
+    if (RFoutFrequency >= 2200000000.0) return ADF4351_RFDIV_1;
+    if (RFoutFrequency >= 1100000000.0) return ADF4351_RFDIV_2;
+    if (RFoutFrequency >= 550000000.0)  return ADF4351_RFDIV_4;
+    if (RFoutFrequency >= 275000000.0)  return ADF4351_RFDIV_8;
+    if (RFoutFrequency >= 137500000.0)  return ADF4351_RFDIV_16;
+    if (RFoutFrequency >= 68750000.0)   return ADF4351_RFDIV_32;
+    return ADF4351_RFDIV_64;
+}
+
+// Steps 1-4 of the original solver; returns whether its own GCD-first,
+// carry-less fix-ups would have written something else
+static int baseline_solve(const check_config_t *cfg, double RFout, words_t *w)
+{
+    double   REFin = cfg->refin_hz, OutputChannelSpacing = cfg->spacing_hz;
+    double   PFDFreq, N;
+    uint16_t OutputDivider, INT, MOD, FRAC, oldMOD, oldFRAC;
+    uint32_t D;
+
+    // 1. Get Ref Setup
+    PFDFreq = (REFin * (cfg->doubler + 1) / (cfg->div2 + 1)) / cfg->r_count;
+
+    // 2. Select Output Divider
+    w->RfDivSel = baseline_divider(RFout);
+    OutputDivider = (1U << w->RfDivSel);
+
+    // 3. Calculate N
+    N = ((RFout * OutputDivider) / PFDFreq);
+
+    // 4. Calculate INT, MOD, FRAC
+    INT = (uint16_t)N;
+    MOD = (uint16_t)(round((PFDFreq / OutputChannelSpacing)));
+    FRAC = (uint16_t)(round(((double)N - INT) * MOD));
+
+    // The original fix-ups, for the report only
+    oldMOD = MOD;
+    oldFRAC = FRAC;
+    if (cfg->gcd) {
+        D = gcd_u32(oldMOD, oldFRAC);
+        oldMOD /= D;
+        oldFRAC /= D;
+    }
+    if (oldMOD == 1) oldMOD = 2;
+
+    // The fix-ups the integer solver applies
+    if (FRAC >= MOD) { INT++; FRAC -= MOD; }
+    if (cfg->gcd) {
+        D = gcd_u32(MOD, FRAC);
+        MOD /= D;
+        FRAC /= D;
+    }
+    if (MOD == 1) { MOD = 2; FRAC *= 2; }
+
+    w->INT = INT;
+    w->FRAC = FRAC;
+    w->MOD = MOD;
+    return (uint64_t)oldFRAC * MOD != (uint64_t)FRAC * oldMOD || (uint16_t)N != INT;
+}
+
+static uint32_t check_config(const check_config_t *cfg)
+{
+    ADF4351_Dev_t dev;
+    uint32_t khz, mismatches = 0, fixed = 0;
+
+    ADF4351_DevInit(&dev, 0);
+    dev.Reg2.b.RCountVal = cfg->r_count;
+    dev.Reg2.b.RMul2 = cfg->doubler;
+    dev.Reg2.b.RDiv2 = cfg->div2;
+
+    for (khz = MIN_FREQ_KHZ; khz <= MAX_FREQ_KHZ; khz++) {
+        ADF4351_FreqWords_t fw;
+        ADF4351_Reg0_t r0;
+        ADF4351_Reg1_t r1;
+        ADF4351_Reg4_t r4;
+        words_t ref;
+
+        fixed += baseline_solve(cfg, khz * 1000.0, &ref);
+        fw.r1 = dev.Reg1.w;
+        fw.r4 = dev.Reg4.w;
+        if (ADF4351_DevCalcFrequencyWords(&dev, khz, cfg->refin_hz, cfg->spacing_hz, cfg->gcd, &fw, NULL) != ADF4351_Err_None) {
+            if (mismatches++ < CHECK_SHOW) printf("  %lu kHz: integer solver failed\n", (unsigned long)khz);
+            continue;
+        }
+        r0.w = fw.r0;
+        r1.w = fw.r1;
+        r4.w = fw.r4;
+        if (r0.b.IntVal == ref.INT && r0.b.FracVal == ref.FRAC && r1.b.ModVal == ref.MOD &&
+            r4.b.RfDivSel == ref.RfDivSel) {
+            continue;
+        }
+        if (mismatches++ < CHECK_SHOW) {
+            printf("  %lu kHz: INT %u/%u FRAC %u/%u MOD %u/%u DIV %u/%u (integer/double)\n",
+                   (unsigned long)khz, r0.b.IntVal, ref.INT, r0.b.FracVal, ref.FRAC,
+                   r1.b.ModVal, ref.MOD, r4.b.RfDivSel, ref.RfDivSel);
+        }
+    }
+    printf("%-40s %lu mismatches, %lu points the original fix-ups got wrong\n",
+           cfg->name, (unsigned long)mismatches, (unsigned long)fixed);
+    return mismatches;
+}
+
+int main(void)
+{
+    uint32_t total = 0;
+    uint8_t  i;
+
+    for (i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) total += check_config(&configs[i]);
+    printf("%s\n", total ? "FAIL" : "PASS");
+    return total ? 1 : 0;
+}
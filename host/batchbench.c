@@ -0,0 +1,170 @@
+/**
+ * @file     batchbench.c
+ * @brief    Batch solver check and benchmark against the scalar path
+ * @date     16 October 2026
+ *
+ * Solves every 1 kHz point from MIN_FREQ_KHZ to MAX_FREQ_KHZ in plans of
+ * BENCH_PLAN points, three ways: ADF4351_UpdateFrequencyRegisters() on
+ * the global shadows, the stateless ADF4351_DevCalcFrequencyWords(), and
+ * ADF4351_BatchSolve(). Reports solves/s for each and checks that the
+ * batch gives the same INT, FRAC, MOD, RfDivSel and achieved frequency as
+ * the scalar solver. Exits non-zero on any mismatch:
+ *
+ *   gcc -O2 -mavx2 -I. -Ihost -o batchbench host/batchbench.c host/adf4351_batch.c adf4351.c -lm
+ *   ./batchbench
+ *
+ * Without -mavx the kernel builds for SSE2, two points per step.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "adf4351.h"
+#include "adf4351_batch.h"
+
+#define MIN_FREQ_KHZ    35000UL             // Same range as main.c
+#define MAX_FREQ_KHZ    4400000UL
+
+#define BENCH_PLAN      4096                // Points per batch call
+#define BENCH_TOL_HZ    1e-4                // Achieved frequency, batch vs exact rational
+#define BENCH_SHOW      5                   // Mismatches printed per setup
+
+typedef struct {
+    const char *name;
+    uint32_t    refin_hz;
+    uint32_t    spacing_hz;
+    uint16_t    r_count;
+    uint8_t     doubler;
+    uint8_t     div2;
+} bench_config_t;
+
+static const bench_config_t configs[] = {
+    { "25 MHz ref, 100 kHz spacing (firmware)", 25000000UL, 100000UL, 1, 0, 0 },
+    { "25 MHz ref, 10 kHz spacing",             25000000UL,  10000UL, 1, 0, 0 },
+    { "10 MHz ref x2, 10 kHz spacing",          10000000UL,  10000UL, 1, 1, 0 },
+    { "100 MHz ref /4, 25 kHz spacing",        100000000UL,  25000UL, 4, 0, 0 },
+    { "26 MHz ref /2 R=1, 6.25 kHz spacing",    26000000UL,   6250UL, 1, 0, 1 },
+    { "25 MHz ref, 25 MHz spacing (MOD 1)",     25000000UL, 25000000UL, 1, 0, 0 },
+};
+
+// One plan's results, scalar side in the same layout as the batch
+static uint32_t plan_khz[BENCH_PLAN];
+static uint16_t s_int[BENCH_PLAN], s_frac[BENCH_PLAN], s_mod[BENCH_PLAN];
+static uint8_t  s_div[BENCH_PLAN];
+static double   s_rfout[BENCH_PLAN];
+static uint16_t b_int[BENCH_PLAN], b_frac[BENCH_PLAN], b_mod[BENCH_PLAN];
+static uint8_t  b_div[BENCH_PLAN], b_status[BENCH_PLAN];
+static double   b_rfout[BENCH_PLAN], b_err[BENCH_PLAN];
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void scalar_store(uint16_t n, const ADF4351_FreqWords_t *w, const ADF4351_Freq_t *f)
+{
+    ADF4351_Reg0_t r0;
+    ADF4351_Reg1_t r1;
+    ADF4351_Reg4_t r4;
+
+    r0.w = w->r0; r1.w = w->r1; r4.w = w->r4;
+    s_int[n] = r0.b.IntVal;
+    s_frac[n] = r0.b.FracVal;
+    s_mod[n] = r1.b.ModVal;
+    s_div[n] = r4.b.RfDivSel;
+    s_rfout[n] = (double)f->Num / f->Den;
+}
+
+static uint32_t run_config(const bench_config_t *cfg)
+{
+    const ADF4351_Batch_t out = { b_int, b_frac, b_mod, b_div, b_rfout, b_err, b_status };
+    ADF4351_Dev_t dev;
+    uint32_t base_r1, base_r4;
+    uint32_t first, mismatches = 0, points = 0;
+    double   t_global = 0, t_stateless = 0, t_batch = 0, worst_hz = 0, t0;
+    uint16_t n, count;
+
+    ADF4351_Init();
+    ADF4351_Reg2.b.RCountVal = cfg->r_count;
+    ADF4351_Reg2.b.RMul2 = cfg->doubler;
+    ADF4351_Reg2.b.RDiv2 = cfg->div2;
+    base_r1 = ADF4351_Reg1.w;
+    base_r4 = ADF4351_Reg4.w;
+    ADF4351_DevInit(&dev, 0);
+    dev.Reg2.w = ADF4351_Reg2.w;
+
+    for (first = MIN_FREQ_KHZ; first <= MAX_FREQ_KHZ; first += count) {
+        count = (MAX_FREQ_KHZ - first + 1 < BENCH_PLAN) ? (uint16_t)(MAX_FREQ_KHZ - first + 1) : BENCH_PLAN;
+        for (n = 0; n < count; n++) plan_khz[n] = first + n;
+
+        // 1. Scalar, global shadows: one point at a time, as the firmware does
+        t0 = now_s();
+        for (n = 0; n < count; n++) {
+            ADF4351_Freq_t f;
+            ADF4351_UpdateFrequencyRegisters(plan_khz[n], cfg->refin_hz, cfg->spacing_hz, 0, 0, &f);
+        }
+        t_global += now_s() - t0;
+
+        // 2. Scalar, stateless: also the reference results
+        t0 = now_s();
+        for (n = 0; n < count; n++) {
+            ADF4351_FreqWords_t w;
+            ADF4351_Freq_t f;
+            w.r1 = base_r1;
+            w.r4 = base_r4;
+            ADF4351_DevCalcFrequencyWords(&dev, plan_khz[n], cfg->refin_hz, cfg->spacing_hz, 0, &w, &f);
+            scalar_store(n, &w, &f);
+        }
+        t_stateless += now_s() - t0;
+
+        // 3. Batch
+        t0 = now_s();
+        if (ADF4351_BatchSolve(plan_khz, count, dev.Reg2.w, cfg->refin_hz, cfg->spacing_hz, &out) != ADF4351_Err_None) {
+            printf("%s: batch rejected the setup\n", cfg->name);
+            return 1;
+        }
+        t_batch += now_s() - t0;
+
+        // 4. Field by field
+        for (n = 0; n < count; n++) {
+            double d = fabs(b_rfout[n] - s_rfout[n]);
+            if (d > worst_hz) worst_hz = d;
+            if (b_int[n] == s_int[n] && b_frac[n] == s_frac[n] && b_mod[n] == s_mod[n] &&
+                b_div[n] == s_div[n] && b_status[n] == ADF4351_Err_None && d <= BENCH_TOL_HZ &&
+                fabs(b_err[n] - (s_rfout[n] - plan_khz[n] * 1000.0)) <= BENCH_TOL_HZ) {
+                continue;
+            }
+            if (mismatches++ < BENCH_SHOW) {
+                printf("  %lu kHz: INT %u/%u FRAC %u/%u MOD %u/%u DIV %u/%u status %u, %.6f Hz off\n",
+                       (unsigned long)plan_khz[n], b_int[n], s_int[n], b_frac[n], s_frac[n],
+                       b_mod[n], s_mod[n], b_div[n], s_div[n], b_status[n], d);
+            }
+        }
+        points += count;
+    }
+
+    printf("%s\n", cfg->name);
+    printf("  global   %6.1f Msolves/s\n", points / t_global / 1e6);
+    printf("  stateless%6.1f Msolves/s\n", points / t_stateless / 1e6);
+    printf("  batch    %6.1f Msolves/s  (x%.1f stateless, x%.1f global)\n", points / t_batch / 1e6,
+           t_stateless / t_batch, t_global / t_batch);
+    printf("  %lu points, %lu mismatches, worst RFout difference %.2e Hz\n",
+           (unsigned long)points, (unsigned long)mismatches, worst_hz);
+    return mismatches;
+}
+
+int main(void)
+{
+    uint32_t total = 0;
+    uint8_t  i;
+
+    for (i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+        total += run_config(&configs[i]);
+    }
+    printf("%s\n", total ? "FAIL" : "PASS");
+    return total ? 1 : 0;
+}
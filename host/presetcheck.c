@@ -0,0 +1,122 @@
+/**
+ * @file     presetcheck.c
+ * @brief    Checks the compile-time preset macros against the runtime solver
+ * @date     16 October 2026
+ *
+ * Evaluates the adf4351_preset.h expressions at run time for every 1 kHz
+ * point from MIN_FREQ_KHZ to MAX_FREQ_KHZ and compares all six words and
+ * the band select anchor with what ADF4351_DevUpdateFrequencyRegisters()
+ * leaves after ADF4351_DevForceBandSelect() (gcd off, automatic band select
+ * clock, lock detect on, as retune.c runs it). Points on a FRAC rounding
+ * tie are counted but skipped, since ADF4351_PRESET_DEFINE refuses them.
+ * Exits non-zero on any mismatch:
+ *
+ *   gcc -O2 -I. -o presetcheck host/presetcheck.c adf4351.c
+ *   ./presetcheck
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "adf4351.h"
+
+// The reference setup under test, instead of the compile-time default
+static uint32_t check_r2;
+#define ADF4351_PRESET_R2 check_r2
+#include "adf4351_preset.h"
+
+#define MIN_FREQ_KHZ    35000UL             // Same range as main.c
+#define MAX_FREQ_KHZ    4400000UL
+#define CHECK_SHOW      5                   // Mismatches printed per setup
+
+typedef struct {
+    const char *name;
+    uint32_t    refin_hz;
+    uint32_t    spacing_hz;
+    uint16_t    r_count;
+    uint8_t     doubler;
+    uint8_t     div2;
+} check_config_t;
+
+static const check_config_t configs[] = {
+    { "25 MHz ref, 100 kHz spacing (firmware)", 25000000UL, 100000UL, 1, 0, 0 },
+    { "25 MHz ref, 10 kHz spacing",             25000000UL,  10000UL, 1, 0, 0 },
+    { "10 MHz ref x2, 10 kHz spacing",          10000000UL,  10000UL, 1, 1, 0 },
+    { "100 MHz ref /4, 25 kHz spacing",        100000000UL,  25000UL, 4, 0, 0 },
+    { "26 MHz ref /2 R=1, 6.25 kHz spacing",    26000000UL,   6250UL, 1, 0, 1 },
+    { "10 MHz ref /100, 1 kHz spacing",         10000000UL,   1000UL, 100, 0, 0 },
+    { "25 MHz ref, 25 MHz spacing (MOD 1)",     25000000UL, 25000000UL, 1, 0, 0 },
+};
+
+static uint32_t check_config(const check_config_t *cfg)
+{
+    ADF4351_Reg2_t r2;
+    ADF4351_Dev_t  dev;
+    uint32_t       k, ties = 0, rejected = 0, mismatches = 0;
+    uint8_t        n;
+
+    r2.w = ADF4351_GOLDEN_R2;
+    r2.b.RCountVal = cfg->r_count;
+    r2.b.RMul2 = cfg->doubler;
+    r2.b.RDiv2 = cfg->div2;
+    r2.b.MuxOut = ADF4351_MUXOUT_DLD;
+    check_r2 = r2.w;
+
+    for (k = MIN_FREQ_KHZ; k <= MAX_FREQ_KHZ; k++) {
+        const ADF4351_Preset_t preset = ADF4351_PRESET(k, cfg->refin_hz, cfg->spacing_hz);
+        uint32_t shadow[6];
+        uint8_t bad = 0;
+
+        if (ADF4351_PRESET_TIE(k, cfg->refin_hz, cfg->spacing_hz)) { ties++; continue; }
+        if (ADF4351_PRESET_MOD0(cfg->refin_hz, cfg->spacing_hz) > 4095 ||
+            ADF4351_PRESET_INT(k, cfg->refin_hz, cfg->spacing_hz) < 75 ||
+            ADF4351_PRESET_INT(k, cfg->refin_hz, cfg->spacing_hz) > 65535) {
+            rejected++;
+            continue;
+        }
+
+        // 1. The runtime path, from a fresh device
+        ADF4351_DevInit(&dev, 0);
+        dev.Reg2.w = check_r2;
+        ADF4351_DevEnableLockDetect(&dev);
+        ADF4351_DevForceBandSelect(&dev);
+        if (ADF4351_DevUpdateFrequencyRegisters(&dev, k, cfg->refin_hz, cfg->spacing_hz, 0, 1, 0) != ADF4351_Err_None) {
+            bad = 1;
+        }
+
+        // 2. Word by word against the macros
+        shadow[0] = dev.Reg0.w; shadow[1] = dev.Reg1.w; shadow[2] = dev.Reg2.w;
+        shadow[3] = dev.Reg3.w; shadow[4] = dev.Reg4.w; shadow[5] = dev.Reg5.w;
+        for (n = 0; n < 6 && !bad; n++) {
+            if (shadow[n] != preset.w[n]) bad = 1;
+        }
+        if (dev.BandAnchorKHz != preset.VcoKHz) bad = 1;
+        if (!bad) continue;
+
+        if (mismatches++ < CHECK_SHOW) {
+            printf("  %lu kHz:\n", (unsigned long)k);
+            for (n = 0; n < 6; n++) {
+                printf("    R%u solver 0x%08lX preset 0x%08lX%s\n", n, (unsigned long)shadow[n],
+                       (unsigned long)preset.w[n], shadow[n] != preset.w[n] ? "  <--" : "");
+            }
+            printf("    VCO solver %lu preset %lu kHz\n",
+                   (unsigned long)dev.BandAnchorKHz, (unsigned long)preset.VcoKHz);
+        }
+    }
+
+    printf("%-40s %9lu checked, %6lu ties, %8lu rejected, %lu mismatches\n", cfg->name,
+           (unsigned long)(MAX_FREQ_KHZ - MIN_FREQ_KHZ + 1 - ties - rejected),
+           (unsigned long)ties, (unsigned long)rejected, (unsigned long)mismatches);
+    return mismatches;
+}
+
+int main(void)
+{
+    uint32_t total = 0;
+    uint8_t  i;
+
+    for (i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+        total += check_config(&configs[i]);
+    }
+    printf("%s\n", total ? "FAIL" : "PASS");
+    return total ? 1 : 0;
+}
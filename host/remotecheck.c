@@ -0,0 +1,314 @@
+/**
+ * @file     remotecheck.c
+ * @brief    Replays recorded byte streams through the remote.c parser
+ * @date     16 October 2026
+ *
+ * Links remote.c against recording handlers and feeds it byte streams as
+ * they would arrive on the USART: good and bad binary frames, frames
+ * split across reads, oversize lengths, over-long text lines, list
+ * uploads and out-of-range values. Each step checks the reply bytes and
+ * the handler calls it caused; only failing steps are printed. The
+ * set_freq handler refuses values outside the band the way main.c does.
+ * Exits non-zero on any mismatch:
+ *
+ *   gcc -O2 -Ihost/sim -I. -DF_CPU=11059200UL -o remotecheck host/remotecheck.c remote.c
+ *   ./remotecheck
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "remote.h"
+#include "retune.h"
+#include "event.h"
+#include "stack.h"
+
+#define CHECK_REPLY_MAX     256
+#define CHECK_LOG_MAX       256
+
+// --- Modules remote.c reads from, not under test ---
+retune_stats_t Retune_Stats;
+event_stats_t  Event_Stats;
+uint16_t Event_IdlePermille(void) { return 0; }
+void     Event_ResetStats(void)   { }
+uint16_t Stack_Gap(void)          { return 0; }
+uint16_t Stack_Unused(void)       { return 0; }
+
+// --- Recording handlers ---
+static uint8_t  reply[CHECK_REPLY_MAX];
+static size_t   reply_len;
+static char     call_log[CHECK_LOG_MAX];
+static bool     list_running;           // A list sweep or hop reads the uploaded list
+
+static void log_call(const char *text)
+{
+    strncat(call_log, text, sizeof(call_log) - strlen(call_log) - 1);
+}
+
+static remote_err_t on_set_freq(uint32_t khz)
+{
+    char buf[32];
+
+    if (khz < ADF4351_RFOUTMIN || khz > ADF4351_RFOUT_MAX) return REMOTE_ERR_RANGE;
+    snprintf(buf, sizeof(buf), "freq %lu;", (unsigned long)khz);
+    log_call(buf);
+    return REMOTE_OK;
+}
+
+static remote_err_t on_set_output(bool on)
+{
+    log_call(on ? "out 1;" : "out 0;");
+    return REMOTE_OK;
+}
+
+static remote_err_t on_set_regs(const uint32_t *words, uint8_t count)
+{
+    char buf[32];
+
+    snprintf(buf, sizeof(buf), "regs %u %08lX;", count, (unsigned long)words[0]);
+    log_call(buf);
+    return REMOTE_OK;
+}
+
+static remote_err_t on_sweep_start(sweep_config_t *config)
+{
+    char buf[64];
+
+    list_running = (config->source == SWEEP_SRC_LIST);
+    if (config->source == SWEEP_SRC_LIST) {
+        snprintf(buf, sizeof(buf), "sweep list %u %lu;", config->list_len, (unsigned long)config->dwell_us);
+    } else {
+        snprintf(buf, sizeof(buf), "sweep %lu %lu %lu %lu;", (unsigned long)config->start_khz,
+                 (unsigned long)config->stop_khz, (unsigned long)config->step_khz,
+                 (unsigned long)config->dwell_us);
+    }
+    log_call(buf);
+    return REMOTE_OK;
+}
+
+static remote_err_t on_hop_start(const uint32_t *list_khz, uint8_t count,
+                                 hop_trigger_t trigger, uint32_t period_us)
+{
+    char buf[48];
+
+    (void)list_khz;
+    list_running = true;
+    snprintf(buf, sizeof(buf), "hop %u %u %lu;", count, trigger, (unsigned long)period_us);
+    log_call(buf);
+    return REMOTE_OK;
+}
+
+static void on_sweep_stop(void)
+{
+    list_running = false;
+    log_call("stop;");
+}
+
+static void on_query(remote_state_t *state)
+{
+    memset(state, 0, sizeof(*state));
+    state->freq_khz = 868000UL;
+    state->output_on = true;
+    state->sweeping = list_running;
+    state->list_busy = list_running;
+}
+
+static void on_write(const uint8_t *data, uint8_t len)
+{
+    if (reply_len + len > sizeof(reply)) len = (uint8_t)(sizeof(reply) - reply_len);
+    memcpy(&reply[reply_len], data, len);
+    reply_len += len;
+}
+
+static const remote_handlers_t handlers PROGMEM = {
+    on_set_freq, on_set_output, on_set_regs, on_sweep_start, on_hop_start,
+    on_sweep_stop, on_query, on_write
+};
+
+// --- Streams ---
+static uint32_t steps, failures;
+
+// Binary frame with its checksum; returns the frame length
+static size_t frame(uint8_t *out, uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    uint8_t sum = cmd + len;
+    uint8_t i;
+
+    out[0] = REMOTE_SYNC;
+    out[1] = cmd;
+    out[2] = len;
+    for (i = 0; i < len; i++) {
+        out[3 + i] = payload[i];
+        sum += payload[i];
+    }
+    out[3 + len] = (uint8_t)-sum;
+    return (size_t)len + 4;
+}
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static void show(const char *what, const uint8_t *data, size_t len)
+{
+    size_t i;
+
+    printf("    %s:", what);
+    for (i = 0; i < len; i++) {
+        if (data[i] >= 0x20 && data[i] < 0x7F) printf(" %c", data[i]);
+        else                                   printf(" %02X", data[i]);
+    }
+    printf("\n");
+}
+
+// Feed a stream, then compare the reply bytes and the handler calls
+static void step(const char *name, const uint8_t *data, size_t len,
+                 const uint8_t *want_reply, size_t want_len, const char *want_log)
+{
+    size_t i;
+
+    steps++;
+    reply_len = 0;
+    call_log[0] = '\0';
+    for (i = 0; i < len; i++) Remote_Feed(data[i]);
+    if (reply_len == want_len && (!want_len || memcmp(reply, want_reply, want_len) == 0) &&
+        strcmp(call_log, want_log) == 0) {
+        return;
+    }
+    failures++;
+    printf("FAIL  %s\n", name);
+    show("reply", reply, reply_len);
+    show("want ", want_reply, want_len);
+    printf("    calls: \"%s\", want \"%s\"\n", call_log, want_log);
+}
+
+static void text(const char *name, const char *line, const char *want_reply, const char *want_log)
+{
+    step(name, (const uint8_t *)line, strlen(line), (const uint8_t *)want_reply, strlen(want_reply), want_log);
+}
+
+static void expect_list(uint16_t len)
+{
+    if (Remote_ListLen() == len) return;
+    failures++;
+    printf("FAIL  list holds %u entries, want %u\n", Remote_ListLen(), len);
+}
+
+int main(void)
+{
+    uint8_t  buf[64], payload[32], nak[8];
+    size_t   n, k;
+    char     line[REMOTE_LINE_MAX + 16];
+    uint8_t  i;
+
+    Remote_Init(&handlers);
+
+    // 1. Text commands and their acknowledge
+    text("text F", "F 868000\r", "OK\r\n", "freq 868000;");
+    text("text F, LF terminated", "f 433920\n", "OK\r\n", "freq 433920;");
+    text("text O", "O 0\r", "OK\r\n", "out 0;");
+    text("text F below the band", "F 10\r", "ERR 3\r\n", "");
+    text("text F above the band", "F 4400001\r", "ERR 3\r\n", "");
+    text("unknown command", "Z\r", "ERR 4\r\n", "");
+
+    // 2. Binary frames: accepted ones are silent, failures NAK
+    put_u32(payload, 2400000UL);
+    n = frame(buf, REMOTE_CMD_FREQ, payload, 4);
+    step("binary FREQ", buf, n, NULL, 0, "freq 2400000;");
+
+    buf[n - 1] ^= 0x55;
+    n = frame(nak, REMOTE_NAK, (const uint8_t[]){ REMOTE_CMD_FREQ, REMOTE_ERR_CHECKSUM }, 2);
+    step("binary bad checksum", buf, 8, nak, n, "");
+
+    put_u32(payload, 1000UL);
+    k = frame(buf, REMOTE_CMD_FREQ, payload, 4);
+    n = frame(nak, REMOTE_NAK, (const uint8_t[]){ REMOTE_CMD_FREQ, REMOTE_ERR_RANGE }, 2);
+    step("binary FREQ below the band", buf, k, nak, n, "");
+
+    buf[0] = REMOTE_SYNC; buf[1] = REMOTE_CMD_LIST; buf[2] = REMOTE_PAYLOAD_MAX + 1;
+    n = frame(nak, REMOTE_NAK, (const uint8_t[]){ REMOTE_CMD_LIST, REMOTE_ERR_LENGTH }, 2);
+    step("binary oversize len", buf, 3, nak, n, "");
+    text("text after an oversize len", "F 100000\r", "OK\r\n", "freq 100000;");
+
+    n = frame(nak, REMOTE_NAK, (const uint8_t[]){ REMOTE_CMD_FREQ, REMOTE_ERR_LENGTH }, 2);
+    k = frame(buf, REMOTE_CMD_FREQ, payload, 2);
+    step("binary FREQ with a short payload", buf, k, nak, n, "");
+
+    // 3. A frame split across reads runs only when its last byte arrives
+    put_u32(payload, 144000UL);
+    n = frame(buf, REMOTE_CMD_FREQ, payload, 4);
+    step("split frame, first part", buf, 5, NULL, 0, "");
+    step("split frame, second part", buf + 5, n - 5, NULL, 0, "freq 144000;");
+
+    // 4. Over-long line: refused whole, the next line is fine
+    memset(line, '1', sizeof(line));
+    line[0] = 'F'; line[1] = ' ';
+    line[sizeof(line) - 2] = '\r';
+    line[sizeof(line) - 1] = '\0';
+    text("line overflow", line, "ERR 2\r\n", "");
+    text("text after a line overflow", "F 50000\r", "OK\r\n", "freq 50000;");
+
+    // 5. List upload, text and binary, then a list sweep and a hop
+    text("list clear", "L\r", "OK\r\n", "");
+    expect_list(0);
+    text("list text", "L 100000 200000 300000\r", "OK\r\n", "");
+    expect_list(3);
+    put_u32(payload, 400000UL);
+    put_u32(payload + 4, 500000UL);
+    n = frame(buf, REMOTE_CMD_LIST, payload, 8);
+    step("list binary", buf, n, NULL, 0, "");
+    expect_list(5);
+    text("list sweep", "WL 500\r", "OK\r\n", "sweep list 5 500;");
+    text("list append during a list sweep", "L 600000\r", "ERR 6\r\n", "");
+    text("list clear during a list sweep", "L\r", "ERR 6\r\n", "");
+    put_u32(payload, 600000UL);
+    n = frame(buf, REMOTE_CMD_LIST, payload, 4);
+    k = frame(nak, REMOTE_NAK, (const uint8_t[]){ REMOTE_CMD_LIST, REMOTE_ERR_BUSY }, 2);
+    step("binary list during a list sweep", buf, n, nak, k, "");
+    expect_list(5);
+    text("hop over the list", "H 1000\r", "OK\r\n", "hop 5 0 1000;");
+    text("list append during a hop", "L 600000\r", "ERR 6\r\n", "");
+    text("list clear during a hop", "L\r", "ERR 6\r\n", "");
+    expect_list(5);
+    text("stop", "X\r", "OK\r\n", "stop;");
+    text("list clear again", "L\r", "OK\r\n", "");
+    for (i = 0; i < REMOTE_LIST_MAX; i++) text("list fill", "L 100000\r", "OK\r\n", "");
+    text("list full", "L 100000\r", "ERR 5\r\n", "");
+    expect_list(REMOTE_LIST_MAX);
+    text("hop over a full list", "H 1000\r", "OK\r\n", "hop 8 0 1000;");
+    text("stop", "X\r", "OK\r\n", "stop;");
+    text("list clear when full", "L\r", "OK\r\n", "");
+
+    // 6. Out-of-range sweep and list values never reach the handlers
+    text("list below the band", "L 1000 2000\r", "ERR 3\r\n", "");
+    expect_list(0);
+    text("list sweep on an empty list", "WL 1000\r", "ERR 3\r\n", "");
+    text("list above the band", "L 100000 4500000\r", "ERR 3\r\n", "");
+    expect_list(1);
+    text("L clear", "L\r", "OK\r\n", "");
+    text("sweep below the band", "W 1000 2000 1 1000\r", "ERR 3\r\n", "");
+    text("sweep above the band", "W 4000000 4500000 100000 1000\r", "ERR 3\r\n", "");
+    text("sweep stop below start", "W 200000 100000 1000 1000\r", "ERR 3\r\n", "");
+    text("sweep in band", "W 100000 200000 1000 1000\r", "OK\r\n", "sweep 100000 200000 1000 1000;");
+
+    put_u32(payload, 1000UL);
+    n = frame(buf, REMOTE_CMD_LIST, payload, 4);
+    k = frame(nak, REMOTE_NAK, (const uint8_t[]){ REMOTE_CMD_LIST, REMOTE_ERR_RANGE }, 2);
+    step("binary list below the band", buf, n, nak, k, "");
+
+    payload[0] = SWEEP_UP; payload[1] = 0;
+    put_u32(payload + 2, 1000UL);
+    put_u32(payload + 6, 1000UL);
+    put_u32(payload + 10, 2000UL);
+    put_u32(payload + 14, 1UL);
+    n = frame(buf, REMOTE_CMD_SWEEP, payload, 18);
+    k = frame(nak, REMOTE_NAK, (const uint8_t[]){ REMOTE_CMD_SWEEP, REMOTE_ERR_RANGE }, 2);
+    step("binary sweep below the band", buf, n, nak, k, "");
+
+    printf("%lu steps, %lu failed\n%s\n", (unsigned long)steps, (unsigned long)failures,
+           failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
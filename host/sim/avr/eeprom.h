@@ -0,0 +1,24 @@
+/**
+ * @file     eeprom.h
+ * @brief    EEPROM access for the host build, backed by host/sim/sim.c
+ * @date     16 October 2026
+ *
+ * Same calls as avr-libc. A write starts the byte and returns; EEWE in
+ * EECR stays set for the write time, and the next access waits it out in
+ * virtual time.
+ */
+
+#ifndef SIM_AVR_EEPROM_H_
+#define SIM_AVR_EEPROM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+uint8_t eeprom_read_byte(const uint8_t *addr);
+void    eeprom_write_byte(uint8_t *addr, uint8_t value);
+void    eeprom_read_block(void *dst, const void *src, size_t n);
+void    eeprom_busy_wait(void);
+
+#define eeprom_is_ready()   (!(EECR & (1 << EEWE)))
+
+#endif /* SIM_AVR_EEPROM_H_ */
@@ -0,0 +1,20 @@
+/**
+ * @file     interrupt.h
+ * @brief    Interrupt glue for the host build
+ * @date     16 October 2026
+ *
+ * ISR() declares a plain function that host/sim/sim.c calls when the
+ * simulated source fires and the I bit in SREG is set. sei() is a sync
+ * point: pending interrupts run before it returns.
+ */
+
+#ifndef SIM_AVR_INTERRUPT_H_
+#define SIM_AVR_INTERRUPT_H_
+
+#include "sim.h"
+
+#define ISR(vector)     void vector(void)
+#define sei()           sim_sei()
+#define cli()           sim_cli()
+
+#endif /* SIM_AVR_INTERRUPT_H_ */
@@ -0,0 +1,137 @@
+/**
+ * @file     io.h
+ * @brief    Simulated ATmega8A register file for the host build
+ * @date     16 October 2026
+ *
+ * Registers are plain variables owned by host/sim/sim.c. Firmware writes
+ * land in them unchanged; the simulator samples them at every delay, sei()
+ * and interrupt boundary and updates the inputs (PINx, ADCW, TCNTn, UDR).
+ */
+
+#ifndef SIM_AVR_IO_H_
+#define SIM_AVR_IO_H_
+
+#include <stdint.h>
+
+// --- Ports ---
+extern volatile uint8_t PORTB, DDRB, PINB;
+extern volatile uint8_t PORTC, DDRC, PINC;
+extern volatile uint8_t PORTD, DDRD, PIND;
+
+// --- Peripherals ---
+extern volatile uint8_t  SREG, MCUCR, GICR, GIFR, TIMSK, TIFR;
+extern volatile uint8_t  TCCR0, TCNT0;
+extern volatile uint8_t  TCCR1A, TCCR1B;
+extern volatile uint16_t TCNT1, OCR1A, OCR1B;
+extern volatile uint8_t  TCCR2, TCNT2, OCR2;
+extern volatile uint8_t  ADMUX, ADCSRA;
+extern volatile uint16_t ADCW;
+extern volatile uint8_t  UCSRA, UCSRB, UCSRC, UBRRH, UBRRL, UDR;
+extern volatile uint8_t  EECR, EEDR;
+extern volatile uint16_t EEAR;
+
+#define RAMEND      0x45F
+#define E2END       0x1FF
+
+// --- Port bits ---
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+// --- MCUCR / GICR / GIFR ---
+#define ISC00 0
+#define ISC01 1
+#define ISC10 2
+#define ISC11 3
+#define SM0   4
+#define SM1   5
+#define SM2   6
+#define SE    7
+#define INT0  6
+#define INT1  7
+#define INTF0 6
+#define INTF1 7
+
+// --- TIMSK / TIFR ---
+#define TOIE0  0
+#define TOIE1  2
+#define OCIE1B 3
+#define OCIE1A 4
+#define TICIE1 5
+#define TOIE2  6
+#define OCIE2  7
+#define TOV0   0
+#define TOV1   2
+#define OCF1B  3
+#define OCF1A  4
+#define ICF1   5
+#define TOV2   6
+#define OCF2   7
+
+// --- Timers ---
+#define CS00  0
+#define CS01  1
+#define CS02  2
+#define CS10  0
+#define CS11  1
+#define CS12  2
+#define WGM12 3
+#define CS20  0
+#define CS21  1
+#define CS22  2
+#define WGM21 3
+#define WGM20 6
+
+// --- ADC ---
+#define REFS1 7
+#define REFS0 6
+#define ADEN  7
+#define ADSC  6
+#define ADFR  5
+#define ADIF  4
+#define ADIE  3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+
+// --- USART ---
+#define RXC   7
+#define TXC   6
+#define UDRE  5
+#define U2X   1
+#define RXCIE 7
+#define TXCIE 6
+#define UDRIE 5
+#define RXEN  4
+#define TXEN  3
+#define URSEL 7
+#define UCSZ1 2
+#define UCSZ0 1
+
+// --- EEPROM ---
+#define EERIE 3
+#define EEMWE 2
+#define EEWE  1
+#define EERE  0
+
+#endif /* SIM_AVR_IO_H_ */
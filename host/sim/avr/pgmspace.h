@@ -0,0 +1,22 @@
+/**
+ * @file     pgmspace.h
+ * @brief    Flash access for the host build: flash is ordinary memory
+ * @date     16 October 2026
+ */
+
+#ifndef SIM_AVR_PGMSPACE_H_
+#define SIM_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s)             (s)
+#define pgm_read_byte(a)    (*(const uint8_t *)(a))
+#define pgm_read_word(a)    (*(const uint16_t *)(a))
+#define pgm_read_dword(a)   (*(const uint32_t *)(a))
+#define pgm_read_ptr(a)     (*(void * const *)(a))
+#define memcpy_P            memcpy
+#define strlen_P            strlen
+
+#endif /* SIM_AVR_PGMSPACE_H_ */
@@ -0,0 +1,26 @@
+/**
+ * @file     sleep.h
+ * @brief    Sleep control for the host build, backed by host/sim/sim.c
+ * @date     16 October 2026
+ *
+ * Same macros as avr-libc, on the MCUCR SM2:0 and SE bits. sleep_cpu()
+ * with SE set advances the virtual clock until an interrupt is taken; all
+ * modes sleep like SLEEP_MODE_IDLE.
+ */
+
+#ifndef SIM_AVR_SLEEP_H_
+#define SIM_AVR_SLEEP_H_
+
+#include "sim.h"
+
+#define SLEEP_MODE_IDLE         0
+#define SLEEP_MODE_ADC          (1 << SM0)
+#define SLEEP_MODE_PWR_DOWN     (1 << SM1)
+
+#define set_sleep_mode(mode) \
+    (MCUCR = (MCUCR & ~((1 << SM2) | (1 << SM1) | (1 << SM0))) | (mode))
+#define sleep_enable()          (MCUCR |= (1 << SE))
+#define sleep_disable()         (MCUCR &= ~(1 << SE))
+#define sleep_cpu()             sim_sleep()
+
+#endif /* SIM_AVR_SLEEP_H_ */
@@ -0,0 +1,918 @@
+/**
+ * @file     sim.c
+ * @brief    Host simulation of the ATmega8A board with a virtual clock
+ * @date     16 October 2026
+ *
+ * See sim.h for the build line and the scenario script format.
+ */
+
+#undef main
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+#include <avr/sleep.h>
+#include "sim.h"
+#include "HostSPI.h"
+#include "SoftwareSPI.h"
+#include "lcd.h"
+#include "uart.h"
+#include "stack.h"
+
+#define SIM_NS_TO_CYCLES(ns)    (((uint64_t)(ns) * F_CPU) / 1000000000ULL)
+#define SIM_MS_TO_CYCLES(ms)    ((uint64_t)((ms) * (F_CPU / 1000.0)))
+#define SIM_CYCLES_TO_MS(c)     ((double)(c) * 1000.0 / F_CPU)
+#define SIM_CYCLES_TO_US(c)     ((double)(c) * 1000000.0 / F_CPU)
+
+#define SIM_UART_BYTE_CYCLES    ((10ULL * F_CPU) / UART_BAUD)   // 8N1
+#define SIM_LCD_CMD_CYCLES      SIM_NS_TO_CYCLES(37000)
+#define SIM_LCD_CLEAR_CYCLES    SIM_NS_TO_CYCLES(1520000)
+#define SIM_LCD_DDRAM           0x80
+#define SIM_ENC_STATE_MS        2.0     // Default: > one Timer0 period per state
+#define SIM_ACTIONS_MAX         4096
+#define SIM_RX_MAX              4096
+#define SIM_NEVER               UINT64_MAX
+
+// ADF4351 lock model: LD drops at every R0 latch and comes back after the
+// band select (10 band-select clocks, skipped with R1 PhaseAdjust) plus a
+// fixed loop settling time, shortened while the fast-lock timer is armed
+#define SIM_LD_PIN              PB4     // ADF_PIN_LD in SoftwareSPI.c
+#define SIM_REFIN_HZ            25000000.0
+#define SIM_PLL_SETTLE_US       30.0
+#define SIM_FASTLOCK_SETTLE_US  10.0
+
+// EEPROM: one byte write takes 8448 cycles of the 1 MHz calibrated oscillator
+#define SIM_EE_SIZE             (E2END + 1)
+#define SIM_EE_WRITE_CYCLES     SIM_NS_TO_CYCLES(8500000)
+
+// --- Register file ---
+volatile uint8_t  PORTB, DDRB, PINB;
+volatile uint8_t  PORTC, DDRC, PINC;
+volatile uint8_t  PORTD, DDRD, PIND;
+volatile uint8_t  SREG, MCUCR, GICR, GIFR, TIMSK, TIFR;
+volatile uint8_t  TCCR0, TCNT0;
+volatile uint8_t  TCCR1A, TCCR1B;
+volatile uint16_t TCNT1, OCR1A, OCR1B;
+volatile uint8_t  TCCR2, TCNT2, OCR2;
+volatile uint8_t  ADMUX, ADCSRA;
+volatile uint16_t ADCW;
+volatile uint8_t  UCSRA, UCSRB, UCSRC, UBRRH, UBRRL, UDR;
+volatile uint8_t  EECR, EEDR;
+volatile uint16_t EEAR;
+
+// --- Firmware entry points ---
+int  firmware_main(void);
+void INT0_vect(void);
+void INT1_vect(void);
+void TIMER2_COMP_vect(void);
+void TIMER1_COMPA_vect(void);
+void TIMER1_COMPB_vect(void);
+void TIMER0_OVF_vect(void);
+void USART_RXC_vect(void);
+void USART_UDRE_vect(void);
+void ADC_vect(void);
+void EE_RDY_vect(void);
+
+// ATmega8 vector order is the priority order
+typedef enum {
+    SIM_VEC_INT0,
+    SIM_VEC_INT1,
+    SIM_VEC_TIMER2_COMP,
+    SIM_VEC_TIMER1_COMPA,
+    SIM_VEC_TIMER1_COMPB,
+    SIM_VEC_TIMER0_OVF,
+    SIM_VEC_USART_RXC,
+    SIM_VEC_USART_UDRE,
+    SIM_VEC_ADC,
+    SIM_VEC_EE_RDY,
+    SIM_VEC_COUNT
+} sim_vec_t;
+
+static void (*const sim_vectors[SIM_VEC_COUNT])(void) = {
+    INT0_vect, INT1_vect, TIMER2_COMP_vect, TIMER1_COMPA_vect, TIMER1_COMPB_vect,
+    TIMER0_OVF_vect, USART_RXC_vect, USART_UDRE_vect, ADC_vect, EE_RDY_vect
+};
+
+static const char *const sim_vector_names[SIM_VEC_COUNT] = {
+    "INT0", "INT1", "TIMER2_COMP", "TIMER1_COMPA", "TIMER1_COMPB",
+    "TIMER0_OVF", "USART_RXC", "USART_UDRE", "ADC", "EE_RDY"
+};
+
+static const uint16_t sim_t01_presc[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+static const uint16_t sim_t2_presc[8]  = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+
+// --- Scenario ---
+typedef enum {
+    SIM_ACT_KEY_DOWN,
+    SIM_ACT_KEY_UP,
+    SIM_ACT_ENC,
+    SIM_ACT_UART,
+    SIM_ACT_INT0,
+    SIM_ACT_INT1,
+    SIM_ACT_LCD,
+    SIM_ACT_EXPECT_LCD,
+    SIM_ACT_EXPECT_LATCH,
+    SIM_ACT_EXPECT_WORD,
+    SIM_ACT_EXPECT_NO_WORD,
+    SIM_ACT_EXPECT_LOCK,
+    SIM_ACT_END
+} sim_act_type_t;
+
+typedef struct {
+    uint64_t       at;          // CPU cycle
+    sim_act_type_t type;
+    int32_t        arg;
+    bool           mark;        // Counts as the input event for latency
+    char          *text;
+    uint16_t       len;
+    uint16_t       line;
+    uint16_t       seq;         // Script order, keeps same-time actions in order
+} sim_action_t;
+
+static sim_action_t sim_actions[SIM_ACTIONS_MAX];
+static uint16_t     sim_action_count, sim_action_next;
+
+// --- Simulator state ---
+static uint64_t sim_now;                // CPU cycles since reset
+static bool     sim_in_isr;
+static uint16_t sim_pending;            // One bit per sim_vec_t
+static uint32_t sim_isr_count[SIM_VEC_COUNT];
+static uint32_t sim_isr_total;
+static bool     sim_sei_took;           // The last sei() ran an ISR
+static uint64_t sim_sleep_first = SIM_NEVER; // First sleep_cpu(), end of the boot code
+static uint64_t sim_sleep_cycles;       // Asleep in sleep_cpu() since then
+static bool     sim_verbose;
+static int      sim_failures;
+
+static uint64_t sim_adc_done;           // 0: no conversion running
+static uint16_t sim_adc_value = 1023;   // Keypad divider output
+
+static uint8_t  sim_rx[SIM_RX_MAX];
+static bool     sim_rx_mark[SIM_RX_MAX];
+static uint16_t sim_rx_head, sim_rx_tail;
+static uint64_t sim_rx_next;
+static uint64_t sim_tx_free;
+static char     sim_tx_line[128];
+static uint8_t  sim_tx_len;
+
+static uint64_t sim_input_at;           // Last scripted input
+static bool     sim_input_waiting;      // No latch since that input
+static uint64_t sim_input_latency;      // Input to first latch, cycles
+static uint32_t sim_input_word;         // host_spi_word_count() at the input
+static uint32_t sim_input_count;        // Inputs that reached a latch
+static uint64_t sim_input_worst;
+
+// ADF4351 model
+static uint32_t sim_adf[6];             // Last word latched per register
+static uint64_t sim_lock_at = SIM_NEVER; // LD goes high here
+static uint64_t sim_lock_last;          // Last R0-to-lock time, cycles
+static uint64_t sim_lock_max;
+static uint32_t sim_relocks;
+static uint32_t sim_early;              // R0 latched before the previous lock, since expect_lock
+
+// EEPROM model
+static uint8_t  sim_ee[SIM_EE_SIZE];
+static uint64_t sim_ee_done;            // Byte write in progress until here
+static uint32_t sim_ee_writes;
+static const char *sim_ee_path;         // -e: image loaded at reset, saved at the end
+
+// HD44780 model
+static char     sim_ddram[0x80];
+static uint8_t  sim_lcd_addr;
+static bool     sim_lcd_4bit, sim_lcd_low, sim_lcd_read_low;
+static uint8_t  sim_lcd_high;
+static uint64_t sim_lcd_busy_until;
+static uint32_t sim_lcd_bytes, sim_lcd_violations;
+
+// --- SoftwareSPI.c is AVR only: its entry points map onto HostSPI ---
+static void sim_spi_init(void)         { host_spi_transport.init(); }
+static void sim_spi_enable(void)       { host_spi_transport.chip_enable(); }
+static void sim_spi_transfer(uint8_t d) { host_spi_transport.transfer(d); }
+static void sim_spi_disable(void)      { host_spi_transport.chip_disable(); }
+static void sim_spi_write32(uint32_t w) { host_spi_transport.write32(w); }
+static uint8_t sim_spi_lock_detect(void) { return (PINB >> SIM_LD_PIN) & 1; }
+
+const spi_transport_t soft_spi_transport = {
+    sim_spi_init, sim_spi_enable, sim_spi_transfer, sim_spi_disable, sim_spi_write32,
+    sim_spi_lock_detect
+};
+
+void soft_spi_init(void) { sim_spi_init(); }
+
+// --- stack.c is AVR only (.init1 painting, linker symbols): no stack to measure ---
+uint16_t Stack_Gap(void)    { return 0; }
+uint16_t Stack_Unused(void) { return 0; }
+
+static void sim_run(uint64_t target);
+
+// --- Keypad: mid-points of the Decode_ADC() ranges ---
+static uint16_t sim_key_adc(char key)
+{
+    static const char     keys[] = "9876543210dukcs";
+    static const uint16_t adc[]  = { 65, 165, 232, 290, 337, 380, 425, 480, 532, 575,
+                                     611, 642, 671, 703, 785 };
+    const char *p = strchr(keys, key);
+
+    return (key && p) ? adc[p - keys] : 1023;
+}
+
+// --- HD44780 ---
+static void sim_lcd_byte(bool rs, uint8_t data)
+{
+    uint64_t busy = SIM_LCD_CMD_CYCLES;
+
+    if (sim_now < sim_lcd_busy_until) sim_lcd_violations++;
+    sim_lcd_bytes++;
+    if (rs) {
+        sim_ddram[sim_lcd_addr & 0x7F] = (char)data;
+        sim_lcd_addr++;
+        if (sim_lcd_addr == 0x28) sim_lcd_addr = 0x40;
+        else if (sim_lcd_addr == 0x68) sim_lcd_addr = 0x00;
+    } else if (data & SIM_LCD_DDRAM) {
+        sim_lcd_addr = data & 0x7F;
+    } else if (data == 0x01) {
+        memset(sim_ddram, ' ', sizeof(sim_ddram));
+        sim_lcd_addr = 0;
+        busy = SIM_LCD_CLEAR_CYCLES;
+    } else if ((data & 0xFE) == 0x02) {
+        sim_lcd_addr = 0;
+        busy = SIM_LCD_CLEAR_CYCLES;
+    }
+    sim_lcd_busy_until = sim_now + busy;
+}
+
+// Called while EN is high: sample the bus like the falling edge would
+static void sim_lcd_pulse(void)
+{
+    bool rs = PORTC & (1 << LCD_RS);
+    uint8_t nibble = PORTD >> 4;
+
+    if (PORTC & (1 << LCD_RW)) {
+        // Busy flag in D7 of the high nibble, the low nibble is the address
+        bool busy = !sim_lcd_read_low && sim_now < sim_lcd_busy_until;
+        PIND = (PIND & 0x7F) | (busy ? 0x80 : 0);
+        sim_lcd_read_low = !sim_lcd_read_low;
+        return;
+    }
+    sim_lcd_read_low = false;
+
+    if (!sim_lcd_4bit) {
+        // 8-bit power-up state: only the high nibble is wired
+        if (nibble == 0x02) sim_lcd_4bit = true;
+        sim_lcd_busy_until = sim_now + SIM_LCD_CMD_CYCLES;
+        return;
+    }
+    if (!sim_lcd_low) {
+        sim_lcd_high = nibble;
+        sim_lcd_low = true;
+        return;
+    }
+    sim_lcd_low = false;
+    sim_lcd_byte(rs, (uint8_t)((sim_lcd_high << 4) | nibble));
+}
+
+static void sim_lcd_row(uint8_t row, char *out)
+{
+    memcpy(out, &sim_ddram[row ? 0x40 : 0x00], LCD_COLS);
+    out[LCD_COLS] = '\0';
+}
+
+static void sim_lcd_print(void)
+{
+    char row[LCD_COLS + 1];
+    uint8_t i;
+
+    for (i = 0; i < LCD_ROWS; i++) {
+        sim_lcd_row(i, row);
+        printf("[%10.3f ms] lcd %u |%s|\n", SIM_CYCLES_TO_MS(sim_now), i, row);
+    }
+}
+
+// --- USART ---
+static void sim_uart_tx(uint8_t data)
+{
+    sim_tx_free = sim_now + SIM_UART_BYTE_CYCLES;
+    if (data == '\n' || sim_tx_len >= sizeof(sim_tx_line) - 5) {
+        sim_tx_line[sim_tx_len] = '\0';
+        if (sim_verbose) printf("[%10.3f ms] uart< %s\n", SIM_CYCLES_TO_MS(sim_now), sim_tx_line);
+        sim_tx_len = 0;
+        if (data == '\n') return;
+    }
+    if (data == '\r') return;
+    if (data >= 0x20 && data < 0x7F) {
+        sim_tx_line[sim_tx_len++] = (char)data;
+    } else {
+        sim_tx_len += sprintf(&sim_tx_line[sim_tx_len], "\\x%02X", data);
+    }
+}
+
+// --- Interrupts ---
+static bool sim_enabled(sim_vec_t v)
+{
+    switch (v) {
+    case SIM_VEC_INT0:          return GICR & (1 << INT0);
+    case SIM_VEC_INT1:          return GICR & (1 << INT1);
+    case SIM_VEC_TIMER2_COMP:   return TIMSK & (1 << OCIE2);
+    case SIM_VEC_TIMER1_COMPA:  return TIMSK & (1 << OCIE1A);
+    case SIM_VEC_TIMER1_COMPB:  return TIMSK & (1 << OCIE1B);
+    case SIM_VEC_TIMER0_OVF:    return TIMSK & (1 << TOIE0);
+    case SIM_VEC_USART_RXC:     return UCSRB & (1 << RXCIE);
+    case SIM_VEC_USART_UDRE:    return (UCSRB & (1 << UDRIE)) && (UCSRB & (1 << TXEN)) &&
+                                       sim_now >= sim_tx_free;
+    case SIM_VEC_ADC:           return ADCSRA & (1 << ADIE);
+    case SIM_VEC_EE_RDY:        return (EECR & (1 << EERIE)) && !(EECR & (1 << EEWE));
+    default:                    return false;
+    }
+}
+
+static void sim_raise(sim_vec_t v)
+{
+    if (sim_enabled(v)) sim_pending |= (1 << v);
+}
+
+// Conversions start whenever the firmware sets ADSC
+static void sim_poll(void)
+{
+    if ((ADCSRA & (1 << ADEN)) && (ADCSRA & (1 << ADSC)) && !sim_adc_done) {
+        uint8_t ps = ADCSRA & 0x07;
+        sim_adc_done = sim_now + 13ULL * (ps ? (1U << ps) : 2U);
+    }
+}
+
+static void sim_call(sim_vec_t v)
+{
+    sim_in_isr = true;
+    SREG &= ~0x80;
+    sim_vectors[v]();
+    SREG |= 0x80;
+    sim_in_isr = false;
+    sim_isr_count[v]++;
+    sim_isr_total++;
+
+    // UDRE either loaded UDR or disabled itself on an empty ring
+    if (v == SIM_VEC_USART_UDRE && (UCSRB & (1 << UDRIE))) sim_uart_tx(UDR);
+    sim_poll();
+}
+
+static void sim_dispatch(void)
+{
+    for (;;) {
+        sim_vec_t v;
+
+        for (v = 0; v < SIM_VEC_COUNT; v++) {
+            if (v == SIM_VEC_USART_UDRE || v == SIM_VEC_EE_RDY) {
+                if (sim_enabled(v)) break;      // Level triggered
+            } else if ((sim_pending & (1 << v)) && sim_enabled(v)) {
+                break;
+            }
+        }
+        if (v == SIM_VEC_COUNT) return;
+        sim_pending &= ~(1 << v);
+        sim_call(v);
+    }
+}
+
+// --- Clock ---
+static uint64_t sim_min(uint64_t a, uint64_t b) { return a < b ? a : b; }
+
+// First cycle after 'from' that is a multiple of period
+static uint64_t sim_next_period(uint64_t from, uint64_t period)
+{
+    return period ? (from / period + 1) * period : SIM_NEVER;
+}
+
+// First cycle after 'from' where TCNT1 reaches ocr
+static uint64_t sim_next_t1(uint64_t from, uint16_t ocr)
+{
+    uint64_t presc = sim_t01_presc[TCCR1B & 0x07];
+    uint64_t tick;
+
+    if (!presc) return SIM_NEVER;
+    tick = from / presc + 1;
+    return (tick + (uint16_t)(ocr - (uint16_t)tick)) * presc;
+}
+
+static uint64_t sim_t0_period(void)
+{
+    return 256ULL * sim_t01_presc[TCCR0 & 0x07];
+}
+
+static uint64_t sim_t2_period(void)
+{
+    if (!(TCCR2 & (1 << WGM21))) return 256ULL * sim_t2_presc[TCCR2 & 0x07];
+    return ((uint64_t)OCR2 + 1) * sim_t2_presc[TCCR2 & 0x07];
+}
+
+static uint64_t sim_next_event(uint64_t from)
+{
+    uint64_t next = SIM_NEVER;
+
+    if (TIMSK & (1 << TOIE0))  next = sim_min(next, sim_next_period(from, sim_t0_period()));
+    if (TIMSK & (1 << OCIE1A)) next = sim_min(next, sim_next_t1(from, OCR1A));
+    if (TIMSK & (1 << OCIE1B)) next = sim_min(next, sim_next_t1(from, OCR1B));
+    if (TIMSK & (1 << OCIE2))  next = sim_min(next, sim_next_period(from, sim_t2_period()));
+    if (sim_adc_done > from)   next = sim_min(next, sim_adc_done);
+    if (sim_rx_head != sim_rx_tail) next = sim_min(next, sim_rx_next > from ? sim_rx_next : from + 1);
+    if ((UCSRB & (1 << UDRIE)) && sim_tx_free > from) next = sim_min(next, sim_tx_free);
+    if ((EECR & (1 << EEWE)) && sim_ee_done > from) next = sim_min(next, sim_ee_done);
+    if (sim_action_next < sim_action_count) {
+        uint64_t at = sim_actions[sim_action_next].at;
+        next = sim_min(next, at > from ? at : from);
+    }
+    return next;
+}
+
+static void sim_update_counters(void)
+{
+    uint64_t presc;
+
+    if ((presc = sim_t01_presc[TCCR0 & 0x07])) TCNT0 = (uint8_t)(sim_now / presc);
+    if ((presc = sim_t01_presc[TCCR1B & 0x07])) TCNT1 = (uint16_t)(sim_now / presc);
+    if ((presc = sim_t2_period())) TCNT2 = (uint8_t)((sim_now % presc) / sim_t2_presc[TCCR2 & 0x07]);
+
+    if ((EECR & (1 << EEWE)) && sim_now >= sim_ee_done) EECR &= ~(1 << EEWE);
+
+    if (sim_now >= sim_lock_at) PINB |= (1 << SIM_LD_PIN);
+    else                        PINB &= ~(1 << SIM_LD_PIN);
+}
+
+static void sim_flag_events(uint64_t from, uint64_t to)
+{
+    if (sim_next_period(from, sim_t0_period()) <= to) sim_raise(SIM_VEC_TIMER0_OVF);
+    if (sim_next_t1(from, OCR1A) <= to) sim_raise(SIM_VEC_TIMER1_COMPA);
+    if (sim_next_t1(from, OCR1B) <= to) sim_raise(SIM_VEC_TIMER1_COMPB);
+    if (sim_next_period(from, sim_t2_period()) <= to) sim_raise(SIM_VEC_TIMER2_COMP);
+
+    if (sim_adc_done && sim_adc_done <= to) {
+        sim_adc_done = 0;
+        ADCW = sim_adc_value;
+        ADCSRA &= ~(1 << ADSC);
+        sim_raise(SIM_VEC_ADC);
+    }
+
+    if (sim_rx_head != sim_rx_tail && sim_rx_next <= to && (UCSRB & (1 << RXEN))) {
+        UDR = sim_rx[sim_rx_tail];
+        if (sim_rx_mark[sim_rx_tail]) {
+            sim_input_at = to;
+            sim_input_waiting = true;
+            sim_input_word = host_spi_word_count();
+        }
+        sim_rx_tail = (sim_rx_tail + 1) % SIM_RX_MAX;
+        sim_rx_next = to + SIM_UART_BYTE_CYCLES;
+        sim_raise(SIM_VEC_USART_RXC);
+    }
+}
+
+// --- Scenario actions ---
+static void sim_finish(void);
+
+static void sim_expect(bool ok, const sim_action_t *a, const char *what)
+{
+    if (ok) {
+        if (sim_verbose) printf("[%10.3f ms] pass  line %u: %s\n", SIM_CYCLES_TO_MS(sim_now), a->line, what);
+        return;
+    }
+    printf("[%10.3f ms] FAIL  line %u: %s\n", SIM_CYCLES_TO_MS(sim_now), a->line, what);
+    sim_failures++;
+}
+
+static void sim_mark_input(void)
+{
+    sim_input_at = sim_now;
+    sim_input_waiting = true;
+    sim_input_word = host_spi_word_count();
+}
+
+static void sim_do_action(const sim_action_t *a)
+{
+    char what[160];
+    char row[LCD_COLS + 1];
+    uint32_t i;
+
+    switch (a->type) {
+    case SIM_ACT_KEY_DOWN:
+        sim_adc_value = sim_key_adc((char)a->arg);
+        sim_mark_input();
+        break;
+    case SIM_ACT_KEY_UP:
+        sim_adc_value = 1023;
+        break;
+    case SIM_ACT_ENC:
+        PINC = (PINC & ~0x03) | (uint8_t)a->arg;
+        if (a->mark) sim_mark_input();
+        break;
+    case SIM_ACT_UART:
+        for (i = 0; i < a->len; i++) {
+            uint16_t next = (sim_rx_head + 1) % SIM_RX_MAX;
+            if (next == sim_rx_tail) break;
+            sim_rx[sim_rx_head] = (uint8_t)a->text[i];
+            sim_rx_mark[sim_rx_head] = (i == a->len - 1u);
+            sim_rx_head = next;
+        }
+        break;
+    case SIM_ACT_INT0:
+    case SIM_ACT_INT1:
+        PIND |= (a->type == SIM_ACT_INT0) ? (1 << PD2) : (1 << PD3);
+        sim_raise(a->type == SIM_ACT_INT0 ? SIM_VEC_INT0 : SIM_VEC_INT1);
+        PIND &= ~((1 << PD2) | (1 << PD3));
+        sim_mark_input();
+        break;
+    case SIM_ACT_LCD:
+        sim_lcd_print();
+        break;
+    case SIM_ACT_EXPECT_LCD:
+        sim_lcd_row((uint8_t)a->arg, row);
+        snprintf(what, sizeof(what), "lcd %d |%s| starts with \"%s\"", a->arg, row, a->text);
+        sim_expect(strncmp(row, a->text, strlen(a->text)) == 0, a, what);
+        break;
+    case SIM_ACT_EXPECT_LATCH:
+        if (sim_input_waiting) {
+            snprintf(what, sizeof(what), "no latch since the input at %.3f ms",
+                     SIM_CYCLES_TO_MS(sim_input_at));
+            sim_expect(false, a, what);
+        } else {
+            snprintf(what, sizeof(what), "input to latch %.1f us <= %d us",
+                     SIM_CYCLES_TO_US(sim_input_latency), a->arg);
+            sim_expect(SIM_CYCLES_TO_US(sim_input_latency) <= a->arg, a, what);
+        }
+        break;
+    case SIM_ACT_EXPECT_WORD:
+    case SIM_ACT_EXPECT_NO_WORD: {
+        bool found = false;
+        for (i = sim_input_word; i < host_spi_word_count(); i++)
+            if (host_spi_word(i) == (uint32_t)a->arg) found = true;
+        snprintf(what, sizeof(what), "word %08X %slatched", (uint32_t)a->arg,
+                 a->type == SIM_ACT_EXPECT_WORD ? "" : "not ");
+        sim_expect(found == (a->type == SIM_ACT_EXPECT_WORD), a, what);
+        break;
+    }
+    case SIM_ACT_EXPECT_LOCK:
+        snprintf(what, sizeof(what), "LD %s, last lock %.1f us <= %d us, %u step(s) before lock",
+                 (PINB & (1 << SIM_LD_PIN)) ? "high" : "low", SIM_CYCLES_TO_US(sim_lock_last),
+                 a->arg, sim_early);
+        sim_expect((PINB & (1 << SIM_LD_PIN)) && SIM_CYCLES_TO_US(sim_lock_last) <= a->arg &&
+                   !sim_early, a, what);
+        sim_early = 0;
+        break;
+    case SIM_ACT_END:
+        sim_finish();
+        break;
+    }
+}
+
+static void sim_run_actions(void)
+{
+    while (sim_action_next < sim_action_count && sim_actions[sim_action_next].at <= sim_now)
+        sim_do_action(&sim_actions[sim_action_next++]);
+}
+
+/** \brief Advance the clock to target, raising and taking interrupts on the way */
+static void sim_run(uint64_t target)
+{
+    while (sim_now < target) {
+        uint64_t from = sim_now;
+        uint64_t to;
+
+        // 1. Next thing that can happen, never past the target
+        sim_poll();
+        to = sim_min(target, sim_next_event(from));
+
+        // 2. Move the clock and flag what fired on the way
+        sim_now = to;
+        sim_update_counters();
+        if (to > from) sim_flag_events(from, to);
+
+        // 3. Scripted inputs due now, then interrupts if the I bit allows
+        sim_run_actions();
+        if ((SREG & 0x80) && !sim_in_isr) sim_dispatch();
+    }
+}
+
+// --- Hooks used by the avr/ and util/ headers ---
+void sim_delay_ns(uint64_t ns)
+{
+    if (PORTC & (1 << LCD_EN)) {
+        sim_lcd_pulse();
+        PORTC &= ~(1 << LCD_EN);                // Next pulse starts a new sample
+    }
+    sim_run(sim_now + SIM_NS_TO_CYCLES(ns));
+}
+
+void sim_sei(void)
+{
+    uint32_t taken = sim_isr_total;
+
+    SREG |= 0x80;
+    if (!sim_in_isr) {
+        sim_poll();
+        sim_dispatch();
+    }
+    sim_sei_took = (sim_isr_total != taken);
+}
+
+void sim_cli(void)
+{
+    SREG &= ~0x80;
+    sim_sei_took = false;
+}
+
+/** \brief sleep_cpu(): run the clock until an interrupt is taken
+ *
+ *  On the AVR the instruction after SEI runs before any interrupt, so a
+ *  source that was already pending at sei(); sleep_cpu(); wakes the CPU at
+ *  once. Here sei() has taken it already; that sleep ends immediately.
+ */
+void sim_sleep(void)
+{
+    uint64_t from = sim_now;
+    uint32_t taken = sim_isr_total;
+
+    if (!(MCUCR & (1 << SE)) || sim_sei_took) return;
+    if (sim_sleep_first == SIM_NEVER) sim_sleep_first = from;
+    while (sim_isr_total == taken) {
+        uint64_t next;
+
+        sim_poll();
+        next = sim_next_event(sim_now);
+        if (next == SIM_NEVER) {
+            printf("[%10.3f ms] asleep with no wake-up source\n", SIM_CYCLES_TO_MS(sim_now));
+            sim_failures++;
+            sim_finish();
+        }
+        sim_run(next > sim_now ? next : sim_now + 1);
+    }
+    sim_sleep_cycles += sim_now - from;
+}
+
+// --- avr/eeprom.h ---
+void eeprom_busy_wait(void)
+{
+    if (EECR & (1 << EEWE)) sim_run(sim_ee_done);
+}
+
+uint8_t eeprom_read_byte(const uint8_t *addr)
+{
+    eeprom_busy_wait();
+    return sim_ee[(uintptr_t)addr % SIM_EE_SIZE];
+}
+
+void eeprom_write_byte(uint8_t *addr, uint8_t value)
+{
+    eeprom_busy_wait();
+    sim_ee[(uintptr_t)addr % SIM_EE_SIZE] = value;
+    sim_ee_done = sim_now + SIM_EE_WRITE_CYCLES;
+    sim_ee_writes++;
+    EECR |= (1 << EEWE);
+}
+
+void eeprom_read_block(void *dst, const void *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) ((uint8_t *)dst)[i] = eeprom_read_byte((const uint8_t *)src + i);
+}
+
+// R0 restarts the PLL: LD low now, high after band select and settling
+static void sim_adf_latch(uint32_t word)
+{
+    uint32_t r1 = sim_adf[1], r2 = sim_adf[2], r3 = sim_adf[3], r4 = sim_adf[4];
+    double pfd, us;
+    uint32_t r, bsc_div;
+
+    if ((word & 7) > 5) return;
+    sim_adf[word & 7] = word;
+    if ((word & 7) != 0) return;
+
+    if (sim_now < sim_lock_at && sim_lock_at != SIM_NEVER) sim_early++;
+    r = (r2 >> 14) & 0x3FF;
+    pfd = SIM_REFIN_HZ * (((r2 >> 25) & 1) + 1) / ((r ? r : 1) * (((r2 >> 24) & 1) + 1));
+    bsc_div = (r4 >> 12) & 0xFF;
+    us = ((r3 >> 15) & 3) == 1 ? SIM_FASTLOCK_SETTLE_US : SIM_PLL_SETTLE_US;
+    if (!((r1 >> 28) & 1)) us += 10.0 * (bsc_div ? bsc_div : 1) * 1e6 / pfd;
+
+    sim_lock_last = SIM_NS_TO_CYCLES(us * 1000.0);
+    if (sim_lock_last > sim_lock_max) sim_lock_max = sim_lock_last;
+    sim_lock_at = sim_now + sim_lock_last;
+    sim_relocks++;
+    PINB &= ~(1 << SIM_LD_PIN);
+    if (sim_verbose)
+        printf("[%10.3f ms] relock in %.1f us\n", SIM_CYCLES_TO_MS(sim_now), us);
+}
+
+static void sim_on_latch(uint32_t word, uint32_t bus_ns)
+{
+    sim_run(sim_now + SIM_NS_TO_CYCLES(bus_ns));
+    sim_adf_latch(word);
+    if (sim_input_waiting) {
+        sim_input_waiting = false;
+        sim_input_latency = sim_now - sim_input_at;
+        sim_input_count++;
+        if (sim_input_latency > sim_input_worst) sim_input_worst = sim_input_latency;
+        if (sim_verbose)
+            printf("[%10.3f ms] input to latch %.1f us\n", SIM_CYCLES_TO_MS(sim_now),
+                   SIM_CYCLES_TO_US(sim_input_latency));
+    }
+    if (sim_verbose) printf("[%10.3f ms] spi R%u %08X\n", SIM_CYCLES_TO_MS(sim_now), word & 7, word);
+}
+
+// --- Script loading ---
+static uint16_t sim_unescape(char *s)
+{
+    char *in = s, *out = s;
+
+    while (*in) {
+        if (*in != '\\' || !in[1]) { *out++ = *in++; continue; }
+        in++;
+        switch (*in) {
+        case 'r': *out++ = '\r'; in++; break;
+        case 'n': *out++ = '\n'; in++; break;
+        case 'x': *out++ = (char)strtoul(in + 1, &in, 16); break;
+        default:  *out++ = *in++; break;
+        }
+    }
+    return (uint16_t)(out - s);
+}
+
+static sim_action_t *sim_add(uint64_t at, sim_act_type_t type, int32_t arg, uint16_t line)
+{
+    sim_action_t *a;
+
+    if (sim_action_count >= SIM_ACTIONS_MAX) {
+        fprintf(stderr, "line %u: too many actions\n", line);
+        exit(2);
+    }
+    a = &sim_actions[sim_action_count++];
+    memset(a, 0, sizeof(*a));
+    a->at = at;
+    a->type = type;
+    a->arg = arg;
+    a->line = line;
+    a->seq = sim_action_count;
+    return a;
+}
+
+static int sim_action_cmp(const void *pa, const void *pb)
+{
+    const sim_action_t *a = pa, *b = pb;
+
+    if (a->at != b->at) return a->at < b->at ? -1 : 1;
+    return (int)a->seq - (int)b->seq;
+}
+
+static void sim_load(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char buf[256];
+    uint16_t line = 0;
+    bool ended = false;
+    uint64_t last = 0;
+
+    if (!f) { perror(path); exit(2); }
+    while (fgets(buf, sizeof(buf), f)) {
+        char *p = buf, *cmd, *rest;
+        double ms;
+        uint64_t at;
+
+        line++;
+        if ((rest = strchr(p, '#'))) *rest = '\0';
+        p[strcspn(p, "\r\n")] = '\0';
+        ms = strtod(p, &cmd);
+        if (cmd == p) {
+            if (strspn(p, " \t") != strlen(p)) { fprintf(stderr, "line %u: no time\n", line); exit(2); }
+            continue;
+        }
+        cmd += strspn(cmd, " \t");
+        rest = cmd + strcspn(cmd, " \t");
+        if (*rest) *rest++ = '\0';
+        rest += strspn(rest, " \t");
+        at = SIM_MS_TO_CYCLES(ms);
+        if (at > last) last = at;
+
+        if (!strcmp(cmd, "key")) {
+            double hold = strtod(rest + 1, 0);
+            sim_add(at, SIM_ACT_KEY_DOWN, rest[0], line);
+            sim_add(at + SIM_MS_TO_CYCLES(hold), SIM_ACT_KEY_UP, 0, line);
+        } else if (!strcmp(cmd, "rot")) {
+            // Detent = 4 states; the Timer0 decoder counts 0-2-3-1-0 as +1
+            static const uint8_t cw[4] = { 2, 3, 1, 0 }, ccw[4] = { 1, 3, 2, 0 };
+            char *end;
+            long n = strtol(rest, &end, 10);
+            double step = strtod(end, 0);
+            long i;
+            if (step <= 0) step = SIM_ENC_STATE_MS;
+            for (i = 0; i < 4 * labs(n); i++) {
+                sim_action_t *a = sim_add(at + SIM_MS_TO_CYCLES(step * i), SIM_ACT_ENC,
+                                          (n > 0 ? cw : ccw)[i % 4], line);
+                a->mark = (i == 4 * labs(n) - 1);
+            }
+        } else if (!strcmp(cmd, "uart")) {
+            sim_action_t *a = sim_add(at, SIM_ACT_UART, 0, line);
+            a->text = strdup(rest);
+            a->len = sim_unescape(a->text);
+        } else if (!strcmp(cmd, "int0")) {
+            sim_add(at, SIM_ACT_INT0, 0, line);
+        } else if (!strcmp(cmd, "int1")) {
+            sim_add(at, SIM_ACT_INT1, 0, line);
+        } else if (!strcmp(cmd, "lcd")) {
+            sim_add(at, SIM_ACT_LCD, 0, line);
+        } else if (!strcmp(cmd, "expect_lcd")) {
+            sim_action_t *a = sim_add(at, SIM_ACT_EXPECT_LCD, rest[0] == '1', line);
+            a->text = strdup(rest[0] && rest[1] ? rest + 2 : "");
+        } else if (!strcmp(cmd, "expect_latch")) {
+            sim_add(at, SIM_ACT_EXPECT_LATCH, (int32_t)strtol(rest, 0, 10), line);
+        } else if (!strcmp(cmd, "expect_word")) {
+            sim_add(at, SIM_ACT_EXPECT_WORD, (int32_t)strtoul(rest, 0, 16), line);
+        } else if (!strcmp(cmd, "expect_no_word")) {
+            sim_add(at, SIM_ACT_EXPECT_NO_WORD, (int32_t)strtoul(rest, 0, 16), line);
+        } else if (!strcmp(cmd, "expect_lock")) {
+            sim_add(at, SIM_ACT_EXPECT_LOCK, (int32_t)strtol(rest, 0, 10), line);
+        } else if (!strcmp(cmd, "end")) {
+            sim_add(at, SIM_ACT_END, 0, line);
+            ended = true;
+        } else {
+            fprintf(stderr, "line %u: unknown action '%s'\n", line, cmd);
+            exit(2);
+        }
+    }
+    fclose(f);
+
+    if (!ended) sim_add(last + SIM_MS_TO_CYCLES(100), SIM_ACT_END, 0, line);
+    qsort(sim_actions, sim_action_count, sizeof(sim_action_t), sim_action_cmp);
+}
+
+// --- Report ---
+static struct timespec sim_wall_start;
+
+static void sim_finish(void)
+{
+    struct timespec end;
+    double wall, virt = SIM_CYCLES_TO_MS(sim_now) / 1000.0;
+    sim_vec_t v;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    wall = (end.tv_sec - sim_wall_start.tv_sec) + (end.tv_nsec - sim_wall_start.tv_nsec) / 1e9;
+
+    sim_lcd_print();
+    printf("virtual %.3f s, wall %.3f s (x%.0f)\n", virt, wall, wall > 0 ? virt / wall : 0);
+    printf("spi: %u words, %.3f ms bus time\n", host_spi_word_count(),
+           host_spi_bus_time_ns() / 1e6);
+    printf("lcd: %u bytes, %u written while busy\n", sim_lcd_bytes, sim_lcd_violations);
+    printf("input: %u latched, worst %.1f us to the first latch\n", sim_input_count,
+           SIM_CYCLES_TO_US(sim_input_worst));
+    if (sim_sleep_first < sim_now)
+        printf("cpu: %.1f%% asleep after boot\n", 100.0 * sim_sleep_cycles / (sim_now - sim_sleep_first));
+    else
+        printf("cpu: never asleep\n");
+    printf("pll: %u relocks, worst %.1f us\n", sim_relocks, SIM_CYCLES_TO_US(sim_lock_max));
+    printf("eeprom: %u byte writes%s\n", sim_ee_writes, (EECR & (1 << EERIE)) ? ", queue not drained" : "");
+    if (sim_ee_path) {
+        FILE *f = fopen(sim_ee_path, "wb");
+        if (f) { fwrite(sim_ee, 1, sizeof(sim_ee), f); fclose(f); }
+    }
+    printf("isr:");
+    for (v = 0; v < SIM_VEC_COUNT; v++)
+        if (sim_isr_count[v]) printf(" %s %u", sim_vector_names[v], sim_isr_count[v]);
+    printf("\n%d expectation(s) failed\n", sim_failures);
+    exit(sim_failures);
+}
+
+int main(int argc, char **argv)
+{
+    int arg = 1;
+
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (!strcmp(argv[arg], "-v")) sim_verbose = true;
+        else if (!strcmp(argv[arg], "-e") && arg + 1 < argc) sim_ee_path = argv[++arg];
+        else break;
+    }
+    if (arg >= argc) {
+        fprintf(stderr, "usage: %s [-v] [-e eeprom.bin] scenario.txt\n", argv[0]);
+        return 2;
+    }
+    sim_load(argv[arg]);
+
+    // Reset state: keypad released, encoder at rest, LCD not busy, EEPROM erased or from -e
+    memset(sim_ddram, ' ', sizeof(sim_ddram));
+    memset(sim_ee, 0xFF, sizeof(sim_ee));
+    if (sim_ee_path) {
+        FILE *f = fopen(sim_ee_path, "rb");
+        if (f) {
+            if (fread(sim_ee, 1, sizeof(sim_ee), f) != sizeof(sim_ee))
+                fprintf(stderr, "%s: short EEPROM image\n", sim_ee_path);
+            fclose(f);
+        }
+    }
+    ADCW = 1023;
+    host_spi_reset();
+    host_spi_set_latch_hook(sim_on_latch);
+    clock_gettime(CLOCK_MONOTONIC, &sim_wall_start);
+
+    firmware_main();
+    sim_finish();
+    return 0;
+}
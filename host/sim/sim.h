@@ -0,0 +1,62 @@
+/**
+ * @file     sim.h
+ * @brief    Host simulation of the ATmega8A board with a virtual clock
+ * @date     16 October 2026
+ *
+ * The firmware sources build unmodified against the headers in host/sim
+ * (avr/io.h, avr/interrupt.h, avr/pgmspace.h, avr/eeprom.h, avr/sleep.h,
+ * util/delay.h), with host/HostSPI.c standing in for SoftwareSPI.c and
+ * stubs in sim.c for stack.c. From the repository root:
+ *
+ *   gcc -O2 -Ihost/sim -Ihost -I. -DF_CPU=11059200UL -Dmain=firmware_main \
+ *       main.c adf4351.c lcd.c sweep.c sweep_table.c uart.c remote.c hop.c \
+ *       profile.c retune.c channel.c event.c host/HostSPI.c host/sim/sim.c -o sim
+ *   ./sim [-v] [-e eeprom.bin] host/sim/scenarios/encoder.txt
+ *
+ * Time only moves in delays, SPI words (HostSPI bus time) and sleeps;
+ * firmware code itself runs in zero virtual time. Interrupts are taken at
+ * those points and at sei(), in ATmega8 vector order. Loops that spin on
+ * a flag set by an ISR without a delay inside never see the ISR run.
+ * sleep_cpu() runs the clock to the next interrupt; since code takes no
+ * time, the summary's share of time asleep is an upper bound.
+ *
+ * The ADF4351 lock-detect output is modelled on PB4: it drops at every R0
+ * latch and rises after the band select time (from R2/R4 as latched) plus
+ * a fixed loop settling time, shorter while R3 arms fast lock.
+ *
+ * The EEPROM starts erased, or from the -e image, which is written back
+ * at the end so a second run sees what the first one stored. A byte write
+ * keeps EEWE set for 8.5 ms; EE_RDY is level triggered like UDRE.
+ *
+ * Scenario script, one action per line, '#' starts a comment:
+ *
+ *   <ms> key <c> <hold_ms>         hold keypad key c ('0'-'9', u d k c s)
+ *   <ms> rot <detents> [state_ms]  turn the encoder, negative is ccw
+ *   <ms> uart <text>               send bytes, C escapes (\r \n \xHH)
+ *   <ms> int0 | int1               rising edge on PD2 / PD3
+ *   <ms> lcd                       print the display
+ *   <ms> expect_lcd <row> <text>   display row starts with text
+ *   <ms> expect_latch <max_us>     the last input reached the ADF4351
+ *                                  (first LE latch) within max_us
+ *   <ms> expect_word <hex>         that word was latched since the last input
+ *   <ms> expect_no_word <hex>      that word was not latched since the last input
+ *   <ms> expect_lock <max_us>      LD is high, the last relock took at most
+ *                                  max_us and no R0 since the previous
+ *                                  expect_lock was latched before the lock
+ *                                  of the one before it
+ *   <ms> end                       stop, print the summary
+ *
+ * Exit status is the number of failed expectations.
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdint.h>
+
+void sim_delay_ns(uint64_t ns);
+void sim_sei(void);
+void sim_cli(void);
+void sim_sleep(void);
+
+#endif /* SIM_H_ */
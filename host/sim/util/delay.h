@@ -0,0 +1,15 @@
+/**
+ * @file     delay.h
+ * @brief    Busy-wait delays for the host build, advance the virtual clock
+ * @date     16 October 2026
+ */
+
+#ifndef SIM_UTIL_DELAY_H_
+#define SIM_UTIL_DELAY_H_
+
+#include "sim.h"
+
+#define _delay_us(us)   sim_delay_ns((uint64_t)((us) * 1000.0))
+#define _delay_ms(ms)   sim_delay_ns((uint64_t)((ms) * 1000000.0))
+
+#endif /* SIM_UTIL_DELAY_H_ */
@@ -0,0 +1,269 @@
+/**
+ * @file     solverbench.c
+ * @brief    Exhaustive solver verification and benchmark for the host
+ * @date     16 October 2026
+ *
+ * Runs each solver over every 1 kHz point from MIN_FREQ_KHZ to MAX_FREQ_KHZ
+ * for a set of reference/spacing setups, split across all cores. Reports
+ * an error histogram, the worst points, register range violations found
+ * by ADF4351_CheckWords() and solves per second. Setups with the GCD step
+ * on must also give exactly the frequency of the same setup without it.
+ * Exits non-zero on any violation or failed solve, so it can gate driver
+ * changes:
+ *
+ *   gcc -O2 -pthread -I. -o solverbench host/solverbench.c adf4351.c
+ *   ./solverbench [threads]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "adf4351.h"
+
+#define MIN_FREQ_KHZ    35000UL             // Same range as main.c
+#define MAX_FREQ_KHZ    4400000UL
+
+#define BENCH_BUCKETS   8
+#define BENCH_WORST     5
+#define BENCH_MAX_THREADS 64
+
+static const char * const bucket_name[BENCH_BUCKETS] = {
+    "exact", "< 1 Hz", "< 10 Hz", "< 100 Hz", "< 1 kHz", "< 10 kHz", "< 100 kHz", ">= 100 kHz"
+};
+
+typedef struct {
+    const char *name;
+    uint32_t    refin_hz;
+    uint32_t    spacing_hz;         // 0: exact mode
+    uint16_t    r_count;
+    uint8_t     doubler;
+    uint8_t     div2;
+    uint8_t     gcd;                // Reduce FRAC/MOD; checked against gcd 0
+} bench_config_t;
+
+static const bench_config_t configs[] = {
+    { "25 MHz ref, 100 kHz spacing (firmware)", 25000000UL, 100000UL, 1, 0, 0, 0 },
+    { "25 MHz ref, 10 kHz spacing",             25000000UL,  10000UL, 1, 0, 0, 0 },
+    { "10 MHz ref x2, 10 kHz spacing",          10000000UL,  10000UL, 1, 1, 0, 0 },
+    { "100 MHz ref /4, 25 kHz spacing",        100000000UL,  25000UL, 4, 0, 0, 0 },
+    { "26 MHz ref /2 R=1, 6.25 kHz spacing",    26000000UL,   6250UL, 1, 0, 1, 0 },
+    { "25 MHz ref, 25 MHz spacing (MOD 1)",     25000000UL, 25000000UL, 1, 0, 0, 0 },
+    { "25 MHz ref, 100 kHz spacing, gcd",       25000000UL, 100000UL, 1, 0, 0, 1 },
+    { "10 MHz ref x2, 10 kHz spacing, gcd",     10000000UL,  10000UL, 1, 1, 0, 1 },
+    { "26 MHz ref /2 R=1, 6.25 kHz, gcd",       26000000UL,   6250UL, 1, 0, 1, 1 },
+    { "25 MHz ref, 25 MHz spacing (MOD 1), gcd", 25000000UL, 25000000UL, 1, 0, 0, 1 },
+    { "25 MHz ref, exact mode",                 25000000UL,       0UL, 1, 0, 0, 0 },
+};
+
+typedef struct {
+    uint32_t khz;
+    double   err_hz;
+} bench_point_t;
+
+typedef struct {
+    const bench_config_t *cfg;
+    uint32_t       r2;
+    uint32_t       base_r1, base_r4;
+    uint32_t       first_khz, last_khz;
+    uint64_t       hist[BENCH_BUCKETS];
+    uint64_t       solves, failures, violations;
+    uint32_t       first_violation_khz;
+    bench_point_t  worst[BENCH_WORST];
+    uint16_t       worst_iter;          // Exact mode: most CF steps in one solve
+    uint32_t       worst_iter_khz;
+} bench_job_t;
+
+static uint8_t bucket_of(double err)
+{
+    double limit = 1.0;
+    uint8_t b;
+
+    if (err == 0.0) return 0;
+    for (b = 1; b < BENCH_BUCKETS - 1; b++, limit *= 10.0) {
+        if (err < limit) return b;
+    }
+    return BENCH_BUCKETS - 1;
+}
+
+static void record(bench_job_t *job, uint32_t khz, const ADF4351_Freq_t *f)
+{
+    uint64_t target = (uint64_t)khz * 1000U * f->Den;
+    uint64_t diff = (f->Num > target) ? f->Num - target : target - f->Num;
+    double err = (double)diff / f->Den;
+    int i, j;
+
+    job->hist[bucket_of(err)]++;
+    for (i = 0; i < BENCH_WORST; i++) {
+        if (err > job->worst[i].err_hz) {
+            for (j = BENCH_WORST - 1; j > i; j--) job->worst[j] = job->worst[j - 1];
+            job->worst[i].khz = khz;
+            job->worst[i].err_hz = err;
+            break;
+        }
+    }
+}
+
+static void violation(bench_job_t *job, uint32_t khz)
+{
+    if (job->violations++ == 0) job->first_violation_khz = khz;
+}
+
+// Fixed-spacing solver: stateless, safe to run on many threads
+static void *run_fixed(void *arg)
+{
+    bench_job_t *job = arg;
+    uint32_t khz;
+
+    for (khz = job->first_khz; khz <= job->last_khz; khz++) {
+        ADF4351_FreqWords_t w, w0;
+        ADF4351_Freq_t f, f0;
+
+        w.r1 = job->base_r1;
+        w.r4 = job->base_r4;
+        job->solves++;
+        if (ADF4351_CalcFrequencyWords(khz, job->cfg->refin_hz, job->cfg->spacing_hz, job->cfg->gcd, &w, &f) != ADF4351_Err_None) {
+            job->failures++;
+            continue;
+        }
+        if (ADF4351_CheckWords(&w, job->r2, job->cfg->refin_hz) != ADF4351_Err_None) violation(job, khz);
+
+        // The GCD step only rescales FRAC/MOD: same Num/Den as without it
+        if (job->cfg->gcd) {
+            w0.r1 = job->base_r1;
+            w0.r4 = job->base_r4;
+            if (ADF4351_CalcFrequencyWords(khz, job->cfg->refin_hz, job->cfg->spacing_hz, 0, &w0, &f0) != ADF4351_Err_None ||
+                (unsigned __int128)f.Num * f0.Den != (unsigned __int128)f0.Num * f.Den) {
+                violation(job, khz);
+            }
+        }
+        record(job, khz, &f);
+    }
+    return NULL;
+}
+
+// Exact mode works on the global shadows, so it runs on a single thread
+static void *run_exact(void *arg)
+{
+    bench_job_t *job = arg;
+    uint32_t khz;
+
+    for (khz = job->first_khz; khz <= job->last_khz; khz++) {
+        ADF4351_FreqWords_t w;
+        ADF4351_Freq_t f;
+
+        job->solves++;
+        if (ADF4351_UpdateFrequencyRegistersExact(khz, job->cfg->refin_hz, &f) != ADF4351_Err_None) {
+            job->failures++;
+            continue;
+        }
+        if (ADF4351_ExactIterations > job->worst_iter) {
+            job->worst_iter = ADF4351_ExactIterations;
+            job->worst_iter_khz = khz;
+        }
+        if (ADF4351_ExactIterations > ADF4351_EXACT_MAX_ITER) violation(job, khz);
+        w.r0 = ADF4351_Reg0.w;
+        w.r1 = ADF4351_Reg1.w;
+        w.r4 = ADF4351_Reg4.w;
+        if (ADF4351_CheckWords(&w, ADF4351_Reg2.w, job->cfg->refin_hz) != ADF4351_Err_None) violation(job, khz);
+        record(job, khz, &f);
+    }
+    return NULL;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int run_config(const bench_config_t *cfg, int threads)
+{
+    static bench_job_t jobs[BENCH_MAX_THREADS];
+    pthread_t tid[BENCH_MAX_THREADS];
+    bench_job_t total;
+    uint32_t span = MAX_FREQ_KHZ - MIN_FREQ_KHZ + 1;
+    double t0, dt;
+    int i, j, k;
+
+    ADF4351_Init();
+    ADF4351_Reg2.b.RCountVal = cfg->r_count;
+    ADF4351_Reg2.b.RMul2 = cfg->doubler;
+    ADF4351_Reg2.b.RDiv2 = cfg->div2;
+    if (cfg->spacing_hz == 0) threads = 1;
+
+    memset(jobs, 0, sizeof(jobs));
+    for (i = 0; i < threads; i++) {
+        jobs[i].cfg = cfg;
+        jobs[i].r2 = ADF4351_Reg2.w;
+        jobs[i].base_r1 = ADF4351_Reg1.w;
+        jobs[i].base_r4 = ADF4351_Reg4.w;
+        jobs[i].first_khz = MIN_FREQ_KHZ + (uint32_t)((uint64_t)span * i / threads);
+        jobs[i].last_khz = MIN_FREQ_KHZ + (uint32_t)((uint64_t)span * (i + 1) / threads) - 1;
+    }
+
+    t0 = now_s();
+    for (i = 0; i < threads; i++) pthread_create(&tid[i], NULL, cfg->spacing_hz ? run_fixed : run_exact, &jobs[i]);
+    for (i = 0; i < threads; i++) pthread_join(tid[i], NULL);
+    dt = now_s() - t0;
+
+    // Merge
+    memset(&total, 0, sizeof(total));
+    for (i = 0; i < threads; i++) {
+        for (j = 0; j < BENCH_BUCKETS; j++) total.hist[j] += jobs[i].hist[j];
+        total.solves += jobs[i].solves;
+        total.failures += jobs[i].failures;
+        if (jobs[i].violations && !total.violations) total.first_violation_khz = jobs[i].first_violation_khz;
+        total.violations += jobs[i].violations;
+        if (jobs[i].worst_iter > total.worst_iter) {
+            total.worst_iter = jobs[i].worst_iter;
+            total.worst_iter_khz = jobs[i].worst_iter_khz;
+        }
+        for (j = 0; j < BENCH_WORST; j++) {
+            for (k = 0; k < BENCH_WORST; k++) {
+                if (jobs[i].worst[j].err_hz > total.worst[k].err_hz) {
+                    memmove(&total.worst[k + 1], &total.worst[k], (BENCH_WORST - 1 - k) * sizeof(bench_point_t));
+                    total.worst[k] = jobs[i].worst[j];
+                    break;
+                }
+            }
+        }
+    }
+
+    printf("%s\n", cfg->name);
+    printf("  %llu solves in %.2f s on %d thread(s): %.1f Msolves/s\n",
+           (unsigned long long)total.solves, dt, threads, total.solves / dt / 1e6);
+    for (j = 0; j < BENCH_BUCKETS; j++) {
+        if (total.hist[j]) printf("  %-11s %10llu\n", bucket_name[j], (unsigned long long)total.hist[j]);
+    }
+    for (j = 0; j < BENCH_WORST && total.worst[j].err_hz > 0; j++) {
+        printf("  worst: %lu kHz off by %.3f Hz\n", (unsigned long)total.worst[j].khz, total.worst[j].err_hz);
+    }
+    if (!cfg->spacing_hz) {
+        printf("  worst %u CF steps at %lu kHz, bound %u (<= %lu AVR cycles)\n", total.worst_iter,
+               (unsigned long)total.worst_iter_khz, ADF4351_EXACT_MAX_ITER, ADF4351_EXACT_MAX_CYCLES);
+    }
+    if (total.failures) printf("  FAILED solves: %llu\n", (unsigned long long)total.failures);
+    if (total.violations) {
+        printf("  VIOLATIONS (range, or gcd changed the frequency): %llu (first at %lu kHz)\n",
+               (unsigned long long)total.violations, (unsigned long)total.first_violation_khz);
+    }
+    return (total.failures || total.violations) ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    int threads = (argc > 1) ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int bad = 0;
+    size_t i;
+
+    if (threads < 1) threads = 1;
+    if (threads > BENCH_MAX_THREADS) threads = BENCH_MAX_THREADS;
+
+    for (i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) bad |= run_config(&configs[i], threads);
+    return bad;
+}
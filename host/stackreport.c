@@ -0,0 +1,110 @@
+/**
+ * @file     stackreport.c
+ * @brief    Per-function stack frames from gcc -fstack-usage output
+ * @date     16 October 2026
+ *
+ * The Release configuration compiles with -fstack-usage, which leaves a
+ * .su file next to every object ("file:line:col:function<TAB>bytes<TAB>
+ * static|dynamic|bounded"). This reads them all and lists the frames
+ * largest first with ISRs marked (__vector_N, or *_vect in the host
+ * build), then the largest ISR and main-path frames. The frames do not
+ * include callees; the deepest the stack actually got on the board is the
+ * M remote command (stack.h), and stack.ld keeps STACK_RESERVE bytes free
+ * for it at link time.
+ *
+ *   gcc -O2 -o stackreport host/stackreport.c
+ *   ./stackreport Release\*.su
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPORT_MAX      512                 // Functions
+#define REPORT_LINE     512
+
+typedef struct {
+    char     where[128];                    // file:line:col
+    char     name[96];
+    char     kind[16];                      // static, dynamic, bounded
+    unsigned bytes;
+    int      isr;
+} frame_t;
+
+static frame_t frames[REPORT_MAX];
+static unsigned frame_count;
+
+static int by_size(const void *a, const void *b)
+{
+    const frame_t *x = a, *y = b;
+
+    if (x->bytes != y->bytes) return x->bytes < y->bytes ? 1 : -1;
+    return strcmp(x->name, y->name);
+}
+
+// One .su line: the function name follows the last ':' of the first
+// field, so Windows paths with a drive letter still parse
+static int parse_line(char *line, frame_t *f)
+{
+    char *tab1 = strchr(line, '\t'), *tab2, *name;
+
+    if (!tab1) return 0;
+    *tab1 = '\0';
+    tab2 = strchr(tab1 + 1, '\t');
+    if (!tab2) return 0;
+    *tab2 = '\0';
+    name = strrchr(line, ':');
+    if (!name) return 0;
+    *name++ = '\0';
+    f->bytes = (unsigned)strtoul(tab1 + 1, NULL, 10);
+    snprintf(f->where, sizeof(f->where), "%.*s", (int)sizeof(f->where) - 1, line);
+    snprintf(f->name, sizeof(f->name), "%.*s", (int)sizeof(f->name) - 1, name);
+    snprintf(f->kind, sizeof(f->kind), "%.*s", (int)strcspn(tab2 + 1, "\r\n,"), tab2 + 1);
+    f->isr = strncmp(name, "__vector_", 9) == 0 ||
+             (strlen(name) > 5 && strcmp(name + strlen(name) - 5, "_vect") == 0);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    const frame_t *isr = NULL, *path = NULL;
+    char line[REPORT_LINE];
+    unsigned i, dynamic = 0;
+    int a;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: stackreport file.su...\n");
+        return 2;
+    }
+    for (a = 1; a < argc; a++) {
+        FILE *in = fopen(argv[a], "r");
+        if (!in) {
+            perror(argv[a]);
+            return 1;
+        }
+        while (fgets(line, sizeof(line), in)) {
+            if (frame_count == REPORT_MAX) {
+                fprintf(stderr, "stackreport: more than %d functions\n", REPORT_MAX);
+                return 1;
+            }
+            if (parse_line(line, &frames[frame_count])) frame_count++;
+        }
+        fclose(in);
+    }
+
+    qsort(frames, frame_count, sizeof(frames[0]), by_size);
+    printf("bytes  kind     function                        location\n");
+    for (i = 0; i < frame_count; i++) {
+        const frame_t *f = &frames[i];
+        printf("%5u  %-7s  %-30s%s  %s\n", f->bytes, f->kind, f->name, f->isr ? " *" : "  ", f->where);
+        if (f->isr && !isr) isr = f;
+        if (!f->isr && !path) path = f;
+        if (strcmp(f->kind, "static") != 0) dynamic++;
+    }
+
+    // ISRs do not nest, so at most one ISR frame sits on top of the main path
+    printf("%u functions (* ISR), %u with a dynamic or bounded frame\n", frame_count, dynamic);
+    if (path) printf("largest main-path frame: %u bytes (%s)\n", path->bytes, path->name);
+    if (isr)  printf("largest ISR frame:       %u bytes (%s)\n", isr->bytes, isr->name);
+    return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file     sweepgen.c
+ * @brief    Offline generator for sweep/preset register tables
+ * @date     16 October 2026
+ *
+ * Solves every point of a frequency plan with the firmware's own
+ * ADF4351_UpdateFrequencyRegisters() and writes a C file holding the
+ * R0/R1/R4 words as a delta-encoded PROGMEM table (see sweep_table.h).
+ * The player takes only the output divider from R4, so the band select
+ * clock and output settings here need not match the target.
+ *
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -I. -o sweepgen host/sweepgen.c adf4351.c
+ *   ./sweepgen -n sweep_2m 144000 146000 25 > sweep_2m.c
+ *   ./sweepgen -n presets -l 100000,433920,868000,2400000 > presets.c
+ *
+ * then add the generated file to SignalGenerator.cproj and declare
+ * "extern const sweep_table_t sweep_2m;" where it is used.
+ *
+ * Options: -r REFin Hz (25000000), -s channel spacing Hz (100000),
+ *          -n table name (sweep_table), -l comma separated kHz list.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "adf4351.h"
+#include "sweep_table.h"
+
+#define SWEEPGEN_MAX_STEPS  65535
+
+static uint32_t plan[SWEEPGEN_MAX_STEPS];
+static uint32_t plan_len;
+
+static void usage(void)
+{
+    fprintf(stderr,
+        "usage: sweepgen [-r refin_hz] [-s spacing_hz] [-n name] start_khz stop_khz step_khz\n"
+        "       sweepgen [-r refin_hz] [-s spacing_hz] [-n name] -l khz,khz,...\n");
+    exit(2);
+}
+
+static void plan_add(uint32_t khz)
+{
+    if (khz < ADF4351_RFOUTMIN || khz > ADF4351_RFOUT_MAX) {
+        fprintf(stderr, "sweepgen: %lu kHz is out of range\n", (unsigned long)khz);
+        exit(1);
+    }
+    if (plan_len >= SWEEPGEN_MAX_STEPS) {
+        fprintf(stderr, "sweepgen: more than %d steps\n", SWEEPGEN_MAX_STEPS);
+        exit(1);
+    }
+    plan[plan_len++] = khz;
+}
+
+static void emit_word(uint32_t w, unsigned *col)
+{
+    int i;
+    for (i = 0; i < 4; i++) {
+        printf("%s0x%02X,", (*col % 12) ? " " : "\n    ", (unsigned)((w >> (8 * i)) & 0xFF));
+        (*col)++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t refin = 25000000UL, spacing = 100000UL;
+    uint32_t start = 0, step = 0;
+    const char *name = "sweep_table";
+    const char *list = NULL;
+    uint32_t prev[3] = {0, 0, 0};
+    unsigned long bytes = 0;
+    unsigned col = 0;
+    uint32_t i;
+    int a = 1;
+
+    for (; a < argc && argv[a][0] == '-'; a++) {
+        if (a + 1 >= argc) usage();
+        switch (argv[a][1]) {
+        case 'r': refin = strtoul(argv[++a], NULL, 0); break;
+        case 's': spacing = strtoul(argv[++a], NULL, 0); break;
+        case 'n': name = argv[++a]; break;
+        case 'l': list = argv[++a]; break;
+        default:  usage();
+        }
+    }
+
+    if (list) {
+        char *copy = strdup(list), *tok;
+        if (a != argc) usage();
+        for (tok = strtok(copy, ", "); tok; tok = strtok(NULL, ", ")) plan_add(strtoul(tok, NULL, 0));
+        free(copy);
+    } else {
+        uint32_t stop, f;
+        if (argc - a != 3) usage();
+        start = strtoul(argv[a], NULL, 0);
+        stop  = strtoul(argv[a + 1], NULL, 0);
+        step  = strtoul(argv[a + 2], NULL, 0);
+        if (step == 0 || stop < start) usage();
+        for (f = start; f <= stop; f += step) plan_add(f);
+    }
+    if (plan_len == 0) usage();
+
+    printf("/* Generated by host/sweepgen.c: %lu steps, REFin %lu Hz, spacing %lu Hz */\n\n",
+           (unsigned long)plan_len, (unsigned long)refin, (unsigned long)spacing);
+    printf("#include <avr/pgmspace.h>\n#include \"sweep_table.h\"\n\n");
+    printf("static const uint8_t %s_data[] PROGMEM = {", name);
+
+    ADF4351_Init();
+    for (i = 0; i < plan_len; i++) {
+        uint32_t w[3];
+        uint8_t  mask = 0;
+        ADF4351_Freq_t f;
+
+        if (ADF4351_UpdateFrequencyRegisters(plan[i], refin, spacing, 0, 0, &f) != ADF4351_Err_None) {
+            fprintf(stderr, "sweepgen: cannot solve %lu kHz\n", (unsigned long)plan[i]);
+            return 1;
+        }
+        w[0] = ADF4351_Reg0.w;
+        w[1] = ADF4351_Reg1.w;
+        w[2] = ADF4351_Reg4.w;
+
+        if (i == 0 || w[0] != prev[0]) mask |= SWEEP_TABLE_R0;
+        if (i == 0 || w[1] != prev[1]) mask |= SWEEP_TABLE_R1;
+        if (i == 0 || w[2] != prev[2]) mask |= SWEEP_TABLE_R4;
+
+        // Same order as SweepTable_Next() reads them: R4, R1, R0
+        printf("%s0x%02X,", (col % 12) ? " " : "\n    ", mask);
+        col++;
+        if (mask & SWEEP_TABLE_R4) emit_word(w[2], &col);
+        if (mask & SWEEP_TABLE_R1) emit_word(w[1], &col);
+        if (mask & SWEEP_TABLE_R0) emit_word(w[0], &col);
+        bytes += 1 + 4 * (((mask & SWEEP_TABLE_R0) != 0) + ((mask & SWEEP_TABLE_R1) != 0) + ((mask & SWEEP_TABLE_R4) != 0));
+
+        memcpy(prev, w, sizeof(prev));
+    }
+
+    printf("\n};\n\nconst sweep_table_t %s = { %s_data, %luU, %luUL, %luUL };\n",
+           name, name, (unsigned long)plan_len, (unsigned long)(list ? plan[0] : start),
+           (unsigned long)(list ? 0 : step));
+
+    fprintf(stderr, "sweepgen: %lu steps, %lu bytes of flash (%lu without delta encoding)\n",
+            (unsigned long)plan_len, bytes, (unsigned long)plan_len * 13UL);
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**
+ * @file     lcd.c
+ * @brief    HD44780 2x16 LCD driver with a RAM framebuffer
+ * @date     16 October 2026
+ */
+
+#ifndef F_CPU
+#define F_CPU 11059200UL
+#endif
+
+#include <avr/interrupt.h>
+#include <util/delay.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+#include "lcd.h"
+#include "event.h"
+
+// Busy flag polls before giving up (RW not wired / display missing),
+// roughly 3 ms at F_CPU
+#define LCD_BUSY_TIMEOUT    1000
+
+// Output queue: data bytes, RS of each slot in lcd_queue_rs. A refresh
+// that does not fit is continued as soon as the queue drains, without
+// waiting out the holdoff; a full two-row redraw (34 bytes) takes ~9 ms
+#define LCD_QUEUE_SIZE      16
+
+// Timer2 CTC tick, one nibble per tick: F_CPU / 32 / (OCR2 + 1), ~127 us
+#define LCD_TICK_OCR2       43
+#define LCD_TICK_US         ((32UL * (LCD_TICK_OCR2 + 1) * 1000000UL) / F_CPU)
+#define LCD_REFRESH_TICKS   ((LCD_REFRESH_MS * 1000UL) / LCD_TICK_US)
+
+static char     lcd_fb[LCD_ROWS][LCD_COLS];     // What the UI wants shown
+static uint16_t lcd_dirty[LCD_ROWS];            // Columns written since they were queued
+static uint8_t  lcd_col, lcd_row;               // Framebuffer cursor
+
+static uint8_t           lcd_queue[LCD_QUEUE_SIZE];
+static uint8_t           lcd_queue_rs[LCD_QUEUE_SIZE / 8];
+static volatile uint8_t  lcd_head, lcd_tail;    // Main loop writes head, ISR advances tail
+static volatile uint8_t  lcd_low_nibble;        // High nibble of lcd_queue[lcd_tail] already sent
+static volatile uint16_t lcd_holdoff;           // Ticks until the next refresh may start
+static bool              lcd_pending;           // Framebuffer changed since the last flush
+static volatile bool     lcd_more;              // The last flush ran out of queue
+
+// --- Low Level ---
+static void LCD_Pulse(void) {
+    LCD_CTRL_PORT |= (1 << LCD_EN);
+    _delay_us(1);
+    LCD_CTRL_PORT &= ~(1 << LCD_EN);
+}
+
+static void LCD_WriteNibble(uint8_t nibble) {
+    uint8_t current = LCD_DATA_PORT & 0x0F;
+    LCD_DATA_PORT = current | (nibble << 4);
+    LCD_Pulse();
+}
+
+// Poll the busy flag (D7) over RW instead of sleeping for the worst case
+static void LCD_WaitBusy(void) {
+    uint16_t timeout = LCD_BUSY_TIMEOUT;
+    uint8_t busy;
+
+    LCD_DATA_DDR &= 0x0F;
+    LCD_CTRL_PORT &= ~(1 << LCD_RS);
+    LCD_CTRL_PORT |= (1 << LCD_RW);
+    do {
+        LCD_CTRL_PORT |= (1 << LCD_EN);
+        _delay_us(1);
+        busy = LCD_DATA_PIN & 0x80;
+        LCD_CTRL_PORT &= ~(1 << LCD_EN);
+        LCD_Pulse();                            // Low nibble, ignored
+    } while (busy && --timeout);
+    LCD_CTRL_PORT &= ~(1 << LCD_RW);
+    LCD_DATA_DDR |= 0xF0;
+}
+
+void LCD_Cmd(uint8_t cmd) {
+    LCD_CTRL_PORT &= ~((1 << LCD_RS) | (1 << LCD_RW)); 
+    LCD_WriteNibble(cmd >> 4);
+    LCD_WriteNibble(cmd & 0x0F);
+    LCD_WaitBusy();
+    if (cmd == 0x01) {
+        // The display is blank now: everything else has to be written again
+        uint8_t row, col;
+        for (row = 0; row < LCD_ROWS; row++)
+            for (col = 0; col < LCD_COLS; col++)
+                if (lcd_fb[row][col] != ' ') lcd_dirty[row] |= (1U << col);
+    }
+}
+
+// Single busy flag read for the ISR: non-zero while the controller is busy
+static uint8_t LCD_IsBusy(void) {
+    uint8_t busy;
+
+    LCD_DATA_DDR &= 0x0F;
+    LCD_CTRL_PORT &= ~(1 << LCD_RS);
+    LCD_CTRL_PORT |= (1 << LCD_RW);
+    LCD_CTRL_PORT |= (1 << LCD_EN);
+    _delay_us(1);
+    busy = LCD_DATA_PIN & 0x80;
+    LCD_CTRL_PORT &= ~(1 << LCD_EN);
+    LCD_Pulse();                                // Low nibble, ignored
+    LCD_CTRL_PORT &= ~(1 << LCD_RW);
+    LCD_DATA_DDR |= 0xF0;
+    return busy;
+}
+
+static bool LCD_Queue(uint8_t data, bool rs) {
+    uint8_t head = lcd_head;
+    uint8_t next = (head + 1) % LCD_QUEUE_SIZE;
+
+    if (next == lcd_tail) return false;
+    lcd_queue[head] = data;
+    if (rs) lcd_queue_rs[head >> 3] |= (1 << (head & 7));
+    else    lcd_queue_rs[head >> 3] &= ~(1 << (head & 7));
+    lcd_head = next;
+    return true;
+}
+
+static uint8_t LCD_QueueFree(void) {
+    return (uint8_t)((lcd_tail + LCD_QUEUE_SIZE - lcd_head - 1) % LCD_QUEUE_SIZE);
+}
+
+// Timer2 tick: keep Timer2 running while there is output or a holdoff
+static void LCD_StartTick(void) {
+    uint8_t sreg = SREG;
+
+    cli();
+    TIMSK |= (1 << OCIE2);
+    SREG = sreg;
+}
+
+static void LCD_SetHoldoff(uint16_t ticks) {
+    uint8_t sreg = SREG;
+
+    cli();
+    lcd_holdoff = ticks;
+    SREG = sreg;
+}
+
+void LCD_Init(void) {
+    LCD_CTRL_DDR |= (1 << LCD_RS) | (1 << LCD_EN) | (1 << LCD_RW);
+    LCD_DATA_DDR |= 0xF0; 
+    LCD_CTRL_PORT &= ~((1 << LCD_RS) | (1 << LCD_EN) | (1 << LCD_RW));
+    memset(lcd_fb, ' ', sizeof(lcd_fb));        // What the clear below leaves
+    // Busy flag is not readable until 4-bit mode is set up: fixed delays here
+    _delay_ms(50); 
+    LCD_WriteNibble(0x03); _delay_ms(5);
+    LCD_WriteNibble(0x03); _delay_us(150);
+    LCD_WriteNibble(0x03); _delay_us(50);
+    LCD_WriteNibble(0x02); _delay_us(50);
+    LCD_Cmd(0x28); LCD_Cmd(0x0C); LCD_Cmd(0x01); 
+    LCD_Clear();
+
+    // Timer2: CTC tick that drains the output queue
+    OCR2 = LCD_TICK_OCR2;
+    TCCR2 = (1 << WGM21) | (1 << CS21) | (1 << CS20);  // clk/32
+}
+
+// --- Framebuffer ---
+void LCD_Clear(void) {
+    uint8_t row, col;
+
+    for (row = 0; row < LCD_ROWS; row++)
+        for (col = 0; col < LCD_COLS; col++) {
+            lcd_col = col;
+            lcd_row = row;
+            LCD_Char(' ');
+        }
+    lcd_col = 0;
+    lcd_row = 0;
+}
+
+void LCD_GotoXY(uint8_t col, uint8_t row) {
+    lcd_col = col;
+    lcd_row = row;
+}
+
+void LCD_Char(char data) {
+    if (lcd_row < LCD_ROWS && lcd_col < LCD_COLS && lcd_fb[lcd_row][lcd_col] != data) {
+        lcd_fb[lcd_row][lcd_col] = data;
+        lcd_dirty[lcd_row] |= (1U << lcd_col);
+    }
+    lcd_col++;
+}
+
+void LCD_String(const char *str) {
+    while (*str) LCD_Char(*str++);
+}
+
+/** \brief LCD_String() for a string in flash (PSTR() or a PROGMEM array) */
+void LCD_String_P(const char *str) {
+    char c;
+    while ((c = pgm_read_byte(str++))) LCD_Char(c);
+}
+
+void LCD_PrintDec(uint32_t n) {
+    if (n == 0) { LCD_Char('0'); return; }
+    char buf[11];
+    uint8_t i = 0;
+    while (n > 0) { buf[i++] = (n % 10) + '0'; n /= 10; }
+    while (i > 0) LCD_Char(buf[--i]);
+}
+
+void LCD_PrintDec3(uint32_t n) {
+    if (n < 100) LCD_Char('0');
+    if (n < 10)  LCD_Char('0');
+    LCD_PrintDec(n);
+}
+
+/** \brief Queue the changed characters; returns how many were queued
+ *
+ *  Never blocks: the Timer2 ISR sends them. A character counts as changed
+ *  once LCD_Char() wrote a different value, even if it was put back
+ *  before the flush. A cursor move costs one command byte, the same as
+ *  rewriting one unchanged character, so gaps of one character are
+ *  written through. Whatever does not fit in the queue goes out when it
+ *  drains (LCD_Service()).
+ */
+uint8_t LCD_Flush(void) {
+    uint8_t sent = 0;
+    uint8_t row, col;
+
+    lcd_pending = false;
+    lcd_more = false;
+    for (row = 0; row < LCD_ROWS; row++) {
+        uint8_t cursor = 0xFF;                  // Display cursor column, unknown
+        for (col = 0; col < LCD_COLS; col++) {
+            if (!(lcd_dirty[row] & (1U << col))) continue;
+            if (LCD_QueueFree() < 2) { lcd_pending = true; lcd_more = true; break; }
+            if (cursor != col) {
+                if (cursor != 0xFF && col == cursor + 1) {
+                    LCD_Queue((uint8_t)lcd_fb[row][cursor], true);
+                    sent++;
+                } else {
+                    LCD_Queue(0x80 | (row ? 0x40 : 0x00) | col, false);
+                }
+            }
+            LCD_Queue((uint8_t)lcd_fb[row][col], true);
+            lcd_dirty[row] &= ~(1U << col);
+            cursor = col + 1;
+            sent++;
+        }
+    }
+    if (sent) LCD_StartTick();
+    return sent;
+}
+
+/** \brief Mark the framebuffer for a refresh at the throttled rate */
+void LCD_Refresh(void) {
+    lcd_pending = true;
+    LCD_Service();
+}
+
+/** \brief Main loop hook: starts a pending refresh once the holdoff ends */
+void LCD_Service(void) {
+    uint16_t holdoff;
+    uint8_t sreg = SREG;
+
+    cli();
+    holdoff = lcd_holdoff;
+    SREG = sreg;
+    if (!lcd_pending || lcd_head != lcd_tail) return;
+
+    // 1. The rest of a refresh that ran out of queue goes out inside its holdoff
+    if (holdoff) {
+        if (lcd_more) LCD_Flush();
+        return;
+    }
+    // 2. Holdoff before queueing so the ISR never sees a drained queue with no holdoff
+    LCD_SetHoldoff(LCD_REFRESH_TICKS);
+    // 3. Nothing changed: no tick needed, no holdoff either
+    if (!LCD_Flush()) LCD_SetHoldoff(0);
+}
+
+bool LCD_Idle(void) {
+    return lcd_head == lcd_tail && !lcd_pending;
+}
+
+// Timer2 Compare: one nibble per tick, HD44780 timing via the busy flag
+ISR(TIMER2_COMP_vect) {
+    if (lcd_holdoff) lcd_holdoff--;
+
+    if (lcd_head == lcd_tail) {
+        // Done: the main loop may start a pending refresh, or finish a cut one
+        if (!lcd_holdoff) {
+            TIMSK &= ~(1 << OCIE2);
+            EVENT_POST(EVENT_LCD);
+        } else if (lcd_more) {
+            EVENT_POST(EVENT_LCD);
+        }
+        return;
+    }
+
+    uint8_t tail = lcd_tail;
+    uint8_t entry = lcd_queue[tail];
+    bool    rs = (lcd_queue_rs[tail >> 3] >> (tail & 7)) & 1;
+    if (!lcd_low_nibble) {
+        if (LCD_IsBusy()) return;
+        if (rs) LCD_CTRL_PORT |= (1 << LCD_RS);
+        else    LCD_CTRL_PORT &= ~(1 << LCD_RS);
+        LCD_WriteNibble(entry >> 4);
+        lcd_low_nibble = 1;
+    } else {
+        if (rs) LCD_CTRL_PORT |= (1 << LCD_RS);
+        else    LCD_CTRL_PORT &= ~(1 << LCD_RS);
+        LCD_WriteNibble(entry & 0x0F);
+        lcd_low_nibble = 0;
+        lcd_tail = (lcd_tail + 1) % LCD_QUEUE_SIZE;
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ * @file     lcd.h
+ * @brief    HD44780 2x16 LCD driver with a RAM framebuffer
+ * @date     16 October 2026
+ *
+ * Writers render into the framebuffer (LCD_GotoXY/LCD_Char/LCD_String...)
+ * and LCD_Flush() queues only the characters that differ from what the
+ * display already shows, moving the cursor only where a run starts.
+ * The queue is drained one nibble per Timer2 tick, so nothing here waits
+ * on the display. LCD_Refresh() limits redraws to one per LCD_REFRESH_MS
+ * and always ends on the latest framebuffer contents.
+ */
+
+#ifndef LCD_H_
+#define LCD_H_
+
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// --- LCD Control (Port C) ---
+#define LCD_CTRL_PORT   PORTC
+#define LCD_CTRL_DDR    DDRC
+#define LCD_RS          PC3
+#define LCD_RW          PC4
+#define LCD_EN          PC5
+
+// --- LCD Data (Port D, high nibble) ---
+#define LCD_DATA_PORT   PORTD
+#define LCD_DATA_DDR    DDRD
+#define LCD_DATA_PIN    PIND
+
+#define LCD_ROWS        2
+#define LCD_COLS        16
+
+// Minimum time between two throttled refreshes
+#define LCD_REFRESH_MS  100
+
+void    LCD_Init(void);
+void    LCD_Cmd(uint8_t cmd);
+
+void    LCD_Clear(void);
+void    LCD_GotoXY(uint8_t col, uint8_t row);
+void    LCD_Char(char data);
+void    LCD_String(const char *str);
+void    LCD_String_P(const char *str);
+void    LCD_PrintDec(uint32_t n);
+void    LCD_PrintDec3(uint32_t n);
+uint8_t LCD_Flush(void);
+void    LCD_Refresh(void);
+void    LCD_Service(void);
+bool    LCD_Idle(void);
+
+#endif /* LCD_H_ */
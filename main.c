@@ -9,23 +9,23 @@
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include <util/delay.h>
 #include <stdbool.h>
 #include <stdlib.h> 
 #include <string.h>
 #include "SoftwareSPI.h" 
 #include "adf4351.h" 
-
-// --- LCD Control (Port C) ---
-#define LCD_CTRL_PORT   PORTC
-#define LCD_CTRL_DDR    DDRC
-#define LCD_RS          PC3
-#define LCD_RW          PC4
-#define LCD_EN          PC5
-
-// --- LCD Data (Port D) ---
-#define LCD_DATA_PORT   PORTD
-#define LCD_DATA_DDR    DDRD
+#include "adf4351_preset.h"
+#include "sweep.h"
+#include "hop.h"
+#include "lcd.h"
+#include "uart.h"
+#include "remote.h"
+#include "profile.h"
+#include "retune.h"
+#include "channel.h"
+#include "event.h"
 
 // --- Rotary Encoder (Port C) ---
 #define ROT_PIN         PINC
@@ -34,22 +34,54 @@
 #define ROT_A           PC0
 #define ROT_B           PC1
 
+// Acceleration: detent interval in Timer0 overflows (1.48 ms) that
+// scales the step x10 / x100, capped at ROT_ACCEL_MAX_STEP_KHZ
+#define ROT_ACCEL_FAST_TICKS    20      // ~30 ms per detent
+#define ROT_ACCEL_TURBO_TICKS   7       // ~10 ms per detent
+#define ROT_ACCEL_MAX_STEP_KHZ  100000UL
+
 #define ADC_KEYPAD_CH   7
+
+// Keypad: Timer0 starts one conversion every KEY_SCAN_DIV overflows; a key
+// counts after KEY_PRESS_MS of the same reading, u/d scan after KEY_LONG_MS
+#define KEY_SCAN_DIV    1               // 1.48 ms per scan
+#define KEY_PRESS_MS    22
+#define KEY_LONG_MS     225
+#define KEY_SCAN_CYCLES (256UL * 64UL * KEY_SCAN_DIV)
+#define KEY_MS_TO_SCANS(ms) \
+    ((uint16_t)(((uint32_t)(ms) * (F_CPU / 1000UL) + KEY_SCAN_CYCLES - 1) / KEY_SCAN_CYCLES))
 #define LED_RUN_PIN     PC2
 
 #define MIN_FREQ_KHZ    35000UL
 #define MAX_FREQ_KHZ    4400000UL
 
+#define REFIN_HZ            25000000UL
+#define CHANNEL_SPACING_HZ  100000UL    // MOD 250 at a 25 MHz PFD
+#define SCAN_DWELL_US       80000UL
+#define LAST_SAVE_TICKS     1350        // ~2 s unchanged before the last-used state is saved
+
+// Fixed-frequency builds (-DBOOT_PRESET_KHZ=...): the boot words are
+// computed by the compiler and go out before the first key press
+#ifdef BOOT_PRESET_KHZ
+static ADF4351_PRESET_DEFINE(boot_preset, BOOT_PRESET_KHZ, REFIN_HZ, CHANNEL_SPACING_HZ);
+#endif
+
 // State Defaults
 volatile uint32_t g_current_freq_khz = 410000UL;
 volatile bool     g_rf_output_on = true; // Starts ON matching Golden Config
 volatile bool     g_scan_mode = false;
 volatile int8_t   g_scan_dir = 0; 
+bool              g_scan_active = false;
 
-const uint32_t STEP_SIZES[4] = {100, 1000, 10000, 100000};
+// Constant tables live in flash (PROGMEM) and are read through pgm_read_*
+static const uint32_t STEP_SIZES[4] PROGMEM = {100, 1000, 10000, 100000};
+static const char     STEP_LABELS[4][5] PROGMEM = {"0.1M", " 1M ", " 10M", "100M"};
+#define STEP_SIZE(i)  pgm_read_dword(&STEP_SIZES[i])
 volatile uint8_t g_step_index = 1; 
 
 volatile int8_t   g_rotary_delta = 0;
+volatile uint8_t  g_rot_idle = 0xFF;    // Overflows since the last detent, saturating
+volatile uint16_t g_ticks = 0;          // Timer0 overflows
 volatile uint8_t  g_key_pressed = 0xFF; 
 volatile bool     g_action_fire = false; 
 
@@ -57,132 +89,243 @@ char    g_input_buf[12];
 uint8_t g_input_pos = 0;
 bool    g_editing = false;
 
-// --- LCD Functions ---
-void LCD_Pulse() {
-    LCD_CTRL_PORT |= (1 << LCD_EN);
-    _delay_us(2);
-    LCD_CTRL_PORT &= ~(1 << LCD_EN);
-    _delay_us(50);
-}
+// --- Wrapper ---
+// Posts to the retune scheduler; the main loop solves and commits the
+// newest post once per pass
+void SetRF_Frequency(uint32_t freq_khz) {
+    if (freq_khz < MIN_FREQ_KHZ) freq_khz = MIN_FREQ_KHZ;
+    if (freq_khz > MAX_FREQ_KHZ) freq_khz = MAX_FREQ_KHZ;
 
-void LCD_WriteNibble(uint8_t nibble) {
-    uint8_t current = LCD_DATA_PORT & 0x0F;
-    LCD_DATA_PORT = current | (nibble << 4);
-    LCD_Pulse();
+    Retune_Post(freq_khz, g_rf_output_on);
 }
 
-void LCD_Cmd(uint8_t cmd) {
-    LCD_CTRL_PORT &= ~((1 << LCD_RS) | (1 << LCD_RW)); 
-    LCD_WriteNibble(cmd >> 4);
-    LCD_WriteNibble(cmd & 0x0F);
-    _delay_ms(2); 
+// Long press on u/d: one timed pass from the current frequency to the band edge.
+// False when there is no room to the edge or the sweep did not start.
+bool Start_Scan(void) {
+    uint32_t step = STEP_SIZE(g_step_index);
+    sweep_config_t cfg;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.source     = SWEEP_SRC_LINEAR;
+    cfg.once       = true;
+    cfg.dwell_us   = SCAN_DWELL_US;
+    cfg.refin_hz   = REFIN_HZ;
+    cfg.spacing_hz = CHANNEL_SPACING_HZ;
+    cfg.step_khz   = step;
+
+    if (g_scan_dir > 0) {
+        if (g_current_freq_khz + step > MAX_FREQ_KHZ) return false;
+        cfg.mode      = SWEEP_UP;
+        cfg.start_khz = g_current_freq_khz + step;
+        cfg.stop_khz  = MAX_FREQ_KHZ;
+    } else {
+        if (g_current_freq_khz < MIN_FREQ_KHZ + step) return false;
+        cfg.mode      = SWEEP_DOWN;
+        cfg.start_khz = g_current_freq_khz - ((g_current_freq_khz - MIN_FREQ_KHZ) / step) * step;
+        cfg.stop_khz  = g_current_freq_khz - step;
+    }
+
+    // Scanning always runs with the output on
+    if (!g_rf_output_on) {
+        g_rf_output_on = true;
+        SetRF_Frequency(g_current_freq_khz);
+    }
+    Retune_Service();
+    return Sweep_Start(&cfg);
 }
 
-void LCD_Char(char data) {
-    LCD_CTRL_PORT |= (1 << LCD_RS);
-    LCD_CTRL_PORT &= ~(1 << LCD_RW); 
-    LCD_WriteNibble(data >> 4);
-    LCD_WriteNibble(data & 0x0F);
-    _delay_us(50);
+// The sweep ISR owns the ADF4351 shadows while it runs; stop it before
+// anything else retunes
+void Stop_Scan(void) {
+    Sweep_Stop();
+    Hop_Stop();
+    Retune_Invalidate();
+    g_scan_mode = false;
+    g_scan_active = false;
 }
 
-void LCD_String(const char *str) {
-    while (*str) LCD_Char(*str++);
+// --- Remote Control ---
+void Update_Screen();
+
+static remote_err_t Remote_SetFreq(uint32_t khz) {
+    if (khz < MIN_FREQ_KHZ || khz > MAX_FREQ_KHZ) return REMOTE_ERR_RANGE;
+    if (g_scan_active) Stop_Scan();
+    g_current_freq_khz = khz;
+    SetRF_Frequency(khz);
+    Update_Screen();
+    return REMOTE_OK;
 }
 
-void LCD_PrintDec(uint32_t n) {
-    if (n == 0) { LCD_Char('0'); return; }
-    char buf[11];
-    uint8_t i = 0;
-    while (n > 0) { buf[i++] = (n % 10) + '0'; n /= 10; }
-    while (i > 0) LCD_Char(buf[--i]);
+static remote_err_t Remote_SetOutput(bool on) {
+    if (g_scan_active) Stop_Scan();
+    g_rf_output_on = on;
+    SetRF_Frequency(g_current_freq_khz);
+    Update_Screen();
+    return REMOTE_OK;
 }
 
-void LCD_PrintDec3(uint32_t n) {
-    if (n < 100) LCD_Char('0');
-    if (n < 10)  LCD_Char('0');
-    LCD_PrintDec(n);
+// Raw words bypass the solver; the control bits select the register.
+// All or nothing: one bad address refuses the whole set
+static remote_err_t Remote_SetRegs(const uint32_t *words, uint8_t count) {
+    uint8_t i;
+
+    for (i = 0; i < count; i++)
+        if ((words[i] & 0x07) > 5) return REMOTE_ERR_RANGE;
+
+    if (g_scan_active) Stop_Scan();
+    for (i = 0; i < count; i++) {
+        uint32_t w = words[i];
+        switch (w & 0x07) {
+        case 0: ADF4351_Reg0.w = w; break;
+        case 1: ADF4351_Reg1.w = w; break;
+        case 2: ADF4351_Reg2.w = w; break;
+        case 3: ADF4351_Reg3.w = w; break;
+        case 4: ADF4351_Reg4.w = w; break;
+        default: ADF4351_Reg5.w = w; break;
+        }
+    }
+    g_rf_output_on = ADF4351_Reg4.b.OutEnable;
+    g_current_freq_khz = ADF4351_FrequencyKHz(REFIN_HZ);
+    ADF4351_CommitRegisters();
+    Retune_Invalidate();
+    Update_Screen();
+    return REMOTE_OK;
 }
 
-void LCD_Init() {
-    LCD_CTRL_DDR |= (1 << LCD_RS) | (1 << LCD_EN) | (1 << LCD_RW);
-    LCD_DATA_DDR |= 0xF0; 
-    LCD_CTRL_PORT &= ~((1 << LCD_RS) | (1 << LCD_EN) | (1 << LCD_RW));
-    _delay_ms(50); 
-    LCD_WriteNibble(0x03); _delay_ms(5);
-    LCD_WriteNibble(0x03); _delay_us(150);
-    LCD_WriteNibble(0x03);
-    LCD_WriteNibble(0x02); 
-    LCD_Cmd(0x28); LCD_Cmd(0x0C); LCD_Cmd(0x01); 
+static remote_err_t Remote_SweepStart(sweep_config_t *cfg) {
+    if (g_scan_active) Stop_Scan();
+    cfg->refin_hz   = REFIN_HZ;
+    cfg->spacing_hz = CHANNEL_SPACING_HZ;
+    if (!g_rf_output_on) {
+        g_rf_output_on = true;
+        SetRF_Frequency(g_current_freq_khz);
+    }
+    Retune_Service();
+    if (!Sweep_Start(cfg)) return REMOTE_ERR_RANGE;
+    g_scan_active = true;
+    return REMOTE_OK;
 }
 
-// --- Wrapper ---
-void SetRF_Frequency(uint32_t freq_khz) {
-    if (freq_khz < MIN_FREQ_KHZ) freq_khz = MIN_FREQ_KHZ;
-    if (freq_khz > MAX_FREQ_KHZ) freq_khz = MAX_FREQ_KHZ;
+static remote_err_t Remote_HopStart(const uint32_t *list_khz, uint8_t count,
+                                    hop_trigger_t trigger, uint32_t period_us) {
+    if (g_scan_active) Stop_Scan();
+    if (!g_rf_output_on) {
+        g_rf_output_on = true;
+        SetRF_Frequency(g_current_freq_khz);
+    }
+    Retune_Service();
+    if (!Hop_Load(list_khz, count, REFIN_HZ, CHANNEL_SPACING_HZ)) return REMOTE_ERR_RANGE;
+    if (!Hop_Start(trigger, period_us)) return REMOTE_ERR_RANGE;
+    g_scan_active = true;
+    return REMOTE_OK;
+}
 
-    // Sync Enable Bit
-    ADF4351_Reg4.b.OutEnable = g_rf_output_on ? 1 : 0;
+static void Remote_SweepStop(void) {
+    if (g_scan_active) Stop_Scan();
+}
 
-    double calc_freq;
-    
-    // FIX: Using 10000.0 (10 kHz) spacing instead of 1000.0 (1 kHz).
-    ADF4351_UpdateFrequencyRegisters(
-        (double)freq_khz * 1000.0, 
-        25000000.0,                
-        100000.0,                    
-        0,                         
-        0,                         
-        &calc_freq                 
-    );
-    ADF4351_UpdateAllRegisters();
+static void Remote_GetState(remote_state_t *state) {
+    state->freq_khz  = g_current_freq_khz;
+    state->output_on = g_rf_output_on;
+    state->sweeping  = Sweep_Running();
+    state->list_busy = Sweep_ListRunning() || Hop_Running();
+    state->overruns  = Sweep_Overruns;
+    state->hop_latency_ns = HOP_TICKS_TO_NS(Hop_LatencyMax);
 }
 
+static const remote_handlers_t remote_handlers PROGMEM = {
+    Remote_SetFreq,
+    Remote_SetOutput,
+    Remote_SetRegs,
+    Remote_SweepStart,
+    Remote_HopStart,
+    Remote_SweepStop,
+    Remote_GetState,
+    UART_WriteBuffer
+};
+
 // --- Inputs ---
+
+// Quadrature transitions, index (prev << 2) | curr: 0-2-3-1-0 counts up,
+// 0-1-3-2-0 counts down, no change and double steps count nothing
+static const int8_t ROT_TABLE[16] PROGMEM = {
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0
+};
+
+// Step multiplier from the time per detent
+static uint8_t Rot_Accel(uint16_t ticks_per_click) {
+    if (ticks_per_click < ROT_ACCEL_TURBO_TICKS) return 100;
+    if (ticks_per_click < ROT_ACCEL_FAST_TICKS)  return 10;
+    return 1;
+}
+
+// Divider voltage to key; 0xFF is no key
+#define KEY_DECODE(adc) \
+    ((adc) > 1000 ? 0xFF : (adc) < 130 ? '9' : (adc) < 200 ? '8' : (adc) < 265 ? '7' : \
+     (adc) < 315  ? '6'  : (adc) < 360 ? '5' : (adc) < 400 ? '4' : (adc) < 450 ? '3' : \
+     (adc) < 510  ? '2'  : (adc) < 555 ? '1' : (adc) < 595 ? '0' : (adc) < 628 ? 'd' : \
+     (adc) < 656  ? 'u'  : (adc) < 687 ? 'k' : (adc) < 720 ? 'c' : (adc) < 850 ? 's' : 0xFF)
+
+// The same ranges sampled in 8-count bins (each bin decoded at its centre),
+// indexed by the top 7 ADC bits: one flash read instead of 16 compares
+#define KEY_ADC_SHIFT   3
+#define KEY_BIN(b)      KEY_DECODE((b) * 8 + 4)
+#define KEY_BINS8(b)    KEY_BIN(b), KEY_BIN(b + 1), KEY_BIN(b + 2), KEY_BIN(b + 3), \
+                        KEY_BIN(b + 4), KEY_BIN(b + 5), KEY_BIN(b + 6), KEY_BIN(b + 7)
+
+static const uint8_t KEY_TABLE[1024 >> KEY_ADC_SHIFT] PROGMEM = {
+    KEY_BINS8(0),   KEY_BINS8(8),   KEY_BINS8(16),  KEY_BINS8(24),
+    KEY_BINS8(32),  KEY_BINS8(40),  KEY_BINS8(48),  KEY_BINS8(56),
+    KEY_BINS8(64),  KEY_BINS8(72),  KEY_BINS8(80),  KEY_BINS8(88),
+    KEY_BINS8(96),  KEY_BINS8(104), KEY_BINS8(112), KEY_BINS8(120)
+};
+
 uint8_t Decode_ADC(uint16_t adc) {
-    if (adc > 1000) return 0xFF;
-    if (adc < 130)  return '9';
-    if (adc < 200)  return '8';
-    if (adc < 265)  return '7';
-    if (adc < 315)  return '6';
-    if (adc < 360)  return '5';
-    if (adc < 400)  return '4';
-    if (adc < 450)  return '3';
-    if (adc < 510)  return '2';
-    if (adc < 555)  return '1';
-    if (adc < 595)  return '0';
-    if (adc < 628)  return 'd'; 
-    if (adc < 656)  return 'u'; 
-    if (adc < 687)  return 'k'; 
-    if (adc < 720)  return 'c'; 
-    if (adc < 850)  return 's'; 
-    return 0xFF;
+    return pgm_read_byte(&KEY_TABLE[adc >> KEY_ADC_SHIFT]);
 }
 
 // --- Interrupts ---
 
 // Timer0 Overflow: Handles Rotary Encoder & LED Heartbeat
 ISR(TIMER0_OVF_vect) {
+    PROFILE_BEGIN(ISR_TIMER0);
     static uint8_t rot_prev = 0;
     static uint8_t hb_cnt = 0;
     
+    static uint8_t key_div = 0;
+    static uint8_t tick_div = 0;
+    
     hb_cnt++;
     if (hb_cnt == 0) LCD_CTRL_PORT ^= (1 << LED_RUN_PIN);
+    g_ticks++;
+    PROFILE_TICK();
 
-    uint8_t rot_curr = ROT_PIN & 0x03; 
-    if (rot_curr != rot_prev) {
-        if ((rot_prev == 0 && rot_curr == 1) || (rot_prev == 1 && rot_curr == 3) || 
-            (rot_prev == 3 && rot_curr == 2) || (rot_prev == 2 && rot_curr == 0)) 
-            g_rotary_delta--;
-        else if ((rot_prev == 0 && rot_curr == 2) || (rot_prev == 2 && rot_curr == 3) || 
-                 (rot_prev == 3 && rot_curr == 1) || (rot_prev == 1 && rot_curr == 0)) 
-            g_rotary_delta++;
-        rot_prev = rot_curr;
+    // Housekeeping wake-up for the timers the main loop keeps in g_ticks
+    if (++tick_div >= EVENT_TICK_DIV) {
+        tick_div = 0;
+        EVENT_POST(EVENT_TICK);
     }
+
+    // Keypad scan rate: the ADC ISR no longer restarts itself
+    if (++key_div >= KEY_SCAN_DIV) {
+        key_div = 0;
+        ADCSRA |= (1 << ADSC);
+    }
+
+    uint8_t rot_curr = ROT_PIN & 0x03; 
+    if (g_rot_idle != 0xFF) g_rot_idle++;
+    g_rotary_delta += (int8_t)pgm_read_byte(&ROT_TABLE[(rot_prev << 2) | rot_curr]);
+    rot_prev = rot_curr;
+    if (g_rotary_delta >= 4 || g_rotary_delta <= -4) EVENT_POST(EVENT_ROTARY);
+    PROFILE_END(ISR_TIMER0);
 }
 
-// ADC Complete: Handles Keypad Scanning (Non-blocking)
+// ADC Complete: Handles Keypad Scanning (Non-blocking), one per Timer0 scan
 ISR(ADC_vect) {
+    PROFILE_BEGIN(ISR_ADC);
     // 1. Read the result
     uint16_t val = ADCW;
     
@@ -192,39 +335,41 @@ ISR(ADC_vect) {
     static uint16_t hold_time = 0;
 
     if (key != 0xFF && key == last_key) {
-        hold_time++;
-        if (hold_time == 300) { 
+        if (hold_time <= KEY_MS_TO_SCANS(KEY_LONG_MS)) hold_time++;
+        if (hold_time == KEY_MS_TO_SCANS(KEY_PRESS_MS)) { 
             g_key_pressed = key; 
             if (key == 'k') g_action_fire = true; 
+            EVENT_POST(EVENT_KEY);
         }
-        if (hold_time > 3000) {
+        if (hold_time > KEY_MS_TO_SCANS(KEY_LONG_MS) && !g_scan_mode) {
             if (key == 'u') { g_scan_mode = true; g_scan_dir = 1; }
             if (key == 'd') { g_scan_mode = true; g_scan_dir = -1; }
+            if (g_scan_mode) EVENT_POST(EVENT_KEY);
         }
     } else {
         hold_time = 0;
         last_key = key;
     }
-
-    // 3. Start the next conversion immediately (Tail Chaining)
-    ADCSRA |= (1 << ADSC);
+    PROFILE_END(ISR_ADC);
 }
 
 // --- Main ---
 void Update_Screen() {
-    LCD_Cmd(0x80); 
+    PROFILE_BEGIN(SCREEN);
+    LCD_Clear();
     if (g_editing) {
-        LCD_String("Set:"); LCD_String(g_input_buf); LCD_String(" MHz  "); 
+        LCD_String_P(PSTR("Set:")); LCD_String(g_input_buf); LCD_String_P(PSTR(" MHz"));
     } else {
         uint32_t mhz = g_current_freq_khz / 1000;
         uint32_t dec = g_current_freq_khz % 1000;
-        LCD_PrintDec(mhz); LCD_Char('.'); LCD_PrintDec3(dec); LCD_String(" MHz ");
+        LCD_PrintDec(mhz); LCD_Char('.'); LCD_PrintDec3(dec); LCD_String_P(PSTR(" MHz"));
     }
-    LCD_Cmd(0xC0); 
-    const char *sl[] = {"0.1M", " 1M ", " 10M", "100M"};
-    LCD_String(sl[g_step_index]);
-    if (g_rf_output_on) LCD_String("  >> ON ");
-    else                LCD_String("     OFF");
+    LCD_GotoXY(0, 1);
+    LCD_String_P(STEP_LABELS[g_step_index]);
+    if (g_rf_output_on) LCD_String_P(PSTR("  >> ON "));
+    else                LCD_String_P(PSTR("     OFF"));
+    LCD_Refresh();
+    PROFILE_END(SCREEN);
 }
 
 uint32_t Parse_Input_Buffer() {
@@ -239,7 +384,29 @@ uint32_t Parse_Input_Buffer() {
 int main(void) {
     LCD_Init();
     soft_spi_init();
+    ADF4351_SetTransport(&soft_spi_transport);
     ADF4351_Init(); // Loads Golden Hex
+    ADF4351_EnableLockDetect();
+    Retune_Init(REFIN_HZ, CHANNEL_SPACING_HZ);
+    Channel_Init(REFIN_HZ, CHANNEL_SPACING_HZ);
+#ifdef BOOT_PRESET_KHZ
+    ADF4351_LoadPreset(&boot_preset);
+    Retune_Loaded(BOOT_PRESET_KHZ);
+    g_current_freq_khz = BOOT_PRESET_KHZ;
+    ADF4351_CommitRegisters();
+#else
+    // Last-used state, stored words: the first main loop pass sends them
+    {
+        uint32_t khz;
+        bool on;
+        if (Channel_Recall(CHANNEL_LAST, &khz, &on)) {
+            g_current_freq_khz = khz;
+            g_rf_output_on = on;
+        }
+    }
+#endif
+    UART_Init();
+    Remote_Init(&remote_handlers);
 	
     ROT_DDR &= ~((1<<ROT_A)|(1<<ROT_B)); 
     ROT_PORT |= (1<<ROT_A)|(1<<ROT_B);   
@@ -250,34 +417,51 @@ int main(void) {
     // Added (1 << ADIE) to enable Interrupts
     ADCSRA = (1 << ADEN) | (1 << ADIE) | (1 << ADPS2) | (1 << ADPS1); 
 
-    // Setup Timer0
+    // Setup Timer0: clk/64, overflow every 1.48 ms; also paces the keypad ADC
     TCCR0 = (1 << CS01) | (1 << CS00); 
     TIMSK |= (1 << TOIE0);
+
+    // Setup Timer1: free-running clk/8 timebase (sweep engine uses OCR1A)
+    TCCR1A = 0;
+    TCCR1B = (1 << CS11);
     
     sei(); // Enable Global Interrupts
 
-    // Start first ADC conversion manually to kick off the chain
-    ADCSRA |= (1 << ADSC);
-
-    LCD_String("RF Generator");
-    LCD_Cmd(0xC0); LCD_String("35M - 4000M");
-    _delay_ms(1000); LCD_Cmd(0x01);
+    LCD_String_P(PSTR("RF Generator"));
+    LCD_GotoXY(0, 1); LCD_String_P(PSTR("35M - 4000M"));
+    LCD_Flush();
+    _delay_ms(1000);
     
     // Force initial load of correct values
     Update_Screen();
+    Event_Init();
 
     while (1) {
-        // Poll_Inputs() removed. ISR(ADC_vect) now handles this.
+        // Sleep until an ISR posts; the checks below are on state, so one
+        // pass handles everything that became ready meanwhile
+        Event_Wait();
 
         if (g_rotary_delta >= 4 || g_rotary_delta <= -4) {
-            uint32_t step = STEP_SIZES[g_step_index];
+            uint32_t step = STEP_SIZE(g_step_index);
             int8_t clicks = 0;
+            uint8_t idle;
             cli();
             clicks = g_rotary_delta / 4; 
             g_rotary_delta %= 4; 
+            idle = g_rot_idle;
+            if (clicks != 0) g_rot_idle = 0;
             sei();
 
             if (clicks != 0) {
+                if (g_scan_active) Stop_Scan();
+
+                // All detents since the last pass go out as one retune,
+                // scaled by how fast they came; the interval saturates, so a
+                // detent after any long pause steps x1
+                uint8_t n = (clicks < 0) ? -clicks : clicks;
+                step *= Rot_Accel(idle / n);
+                if (step > ROT_ACCEL_MAX_STEP_KHZ) step = ROT_ACCEL_MAX_STEP_KHZ;
+
                 int32_t change = (int32_t)clicks * (int32_t)step;
                 
                 if (clicks > 0) {
@@ -290,40 +474,41 @@ int main(void) {
                 }
 
                 if (g_rf_output_on) SetRF_Frequency(g_current_freq_khz);
-			    ADF4351_UpdateAllRegisters();
 
                 Update_Screen();
             }
         }
 
-        if (g_scan_mode) {
-            uint32_t step = STEP_SIZES[g_step_index];
-            if (g_scan_dir > 0) g_current_freq_khz += step;
-            else                g_current_freq_khz -= step;
-            if (g_current_freq_khz > MAX_FREQ_KHZ) g_current_freq_khz = MAX_FREQ_KHZ;
-            if (g_current_freq_khz < MIN_FREQ_KHZ) g_current_freq_khz = MIN_FREQ_KHZ;
-
-            if (!g_rf_output_on) g_rf_output_on = true;
-            SetRF_Frequency(g_current_freq_khz);
+        if (g_scan_mode && !g_scan_active) {
+            if (Start_Scan()) g_scan_active = true;
+            else              g_scan_mode = false;
             Update_Screen();
-            _delay_ms(80);
+        }
+
+        if (g_scan_active) {
+            // Steps and hops are written by their ISRs; here we only stage
+            // the next sweep point and follow the display
+            Sweep_Service();
+            uint32_t khz = Hop_Running() ? Hop_CurrentKHz() : Sweep_CurrentKHz();
+            if (khz != g_current_freq_khz) {
+                g_current_freq_khz = khz;
+                Update_Screen();
+            }
         }
 
         if (g_key_pressed != 0xFF) {
             uint8_t key = g_key_pressed;
             g_key_pressed = 0xFF;
 
-            if (g_scan_mode) {
-                g_scan_mode = false;
+            if (g_scan_mode || g_scan_active) {
+                Stop_Scan();
                 if (key == 'c') {
                     g_rf_output_on = false;
                     SetRF_Frequency(g_current_freq_khz);
                     Update_Screen();
                 }
-                continue;
             }
-
-            if (key >= '0' && key <= '9') {
+            else if (key >= '0' && key <= '9') {
                 if (!g_editing) {
                     g_editing = true; g_input_pos = 0;
                     memset(g_input_buf, 0, 12);
@@ -342,6 +527,25 @@ int main(void) {
                 SetRF_Frequency(g_current_freq_khz);
                 Update_Screen();
             }
+            else if (key == 's' && g_editing) {
+                // Number + s: store the current state in that channel
+                uint32_t ch = Parse_Input_Buffer();
+                g_editing = false;
+                if (ch < CHANNEL_COUNT) Channel_Store((uint8_t)ch, g_current_freq_khz, g_rf_output_on);
+                Update_Screen();
+            }
+            else if (key == 'u' && g_editing) {
+                // Number + u: recall that channel
+                uint32_t ch = Parse_Input_Buffer();
+                uint32_t khz;
+                bool on;
+                g_editing = false;
+                if (ch < CHANNEL_COUNT && Channel_Recall((uint8_t)ch, &khz, &on)) {
+                    g_current_freq_khz = khz;
+                    g_rf_output_on = on;
+                }
+                Update_Screen();
+            }
             else if (key == 's') {
                 g_step_index = (g_step_index + 1) % 4;
                 Update_Screen();
@@ -353,13 +557,42 @@ int main(void) {
                 Update_Screen();
             }
             else if (key == 'u' || key == 'd') {
-                uint32_t step = STEP_SIZES[g_step_index];
-                if (key == 'u') g_current_freq_khz += step;
-                else            g_current_freq_khz -= step;
+                uint32_t step = STEP_SIZE(g_step_index);
+                // Clamped here as well, so the display never leaves the band the chip is held to
+                if (key == 'u') g_current_freq_khz = (MAX_FREQ_KHZ - g_current_freq_khz < step) ?
+                                                     MAX_FREQ_KHZ : g_current_freq_khz + step;
+                else            g_current_freq_khz = (g_current_freq_khz < MIN_FREQ_KHZ + step) ?
+                                                     MIN_FREQ_KHZ : g_current_freq_khz - step;
                 if (g_rf_output_on) SetRF_Frequency(g_current_freq_khz);
                 Update_Screen();
             }
         }
-        _delay_us(100);
+        // Remote commands run in arrival order; binary frames are not
+        // acknowledged, so the host never waits on a round trip
+        int16_t rx;
+        while ((rx = UART_Read()) >= 0) Remote_Feed((uint8_t)rx);
+
+        // Only the newest target of this pass reaches the chip
+        Retune_Service();
+
+        // The last-used state goes to EEPROM once it has stayed put
+        if (!g_scan_active && !g_editing) {
+            static uint32_t save_khz;
+            static bool     save_on, save_due;
+            static uint16_t save_ticks;
+            uint16_t now;
+            cli();
+            now = g_ticks;
+            sei();
+            if (g_current_freq_khz != save_khz || g_rf_output_on != save_on) {
+                save_khz = g_current_freq_khz;
+                save_on = g_rf_output_on;
+                save_ticks = now;
+                save_due = true;
+            } else if (save_due && (uint16_t)(now - save_ticks) >= LAST_SAVE_TICKS) {
+                save_due = !Channel_Store(CHANNEL_LAST, save_khz, save_on);
+            }
+        }
+        LCD_Service();
     }
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+/**
+ * @file     profile.c
+ * @brief    Hot-path profiler timed by the free-running Timer1
+ * @date     16 October 2026
+ */
+
+#include "profile.h"
+
+#ifdef PROFILE_ENABLE
+
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+
+typedef struct {
+    uint16_t count;
+    uint16_t min;
+    uint16_t max;
+    uint32_t sum;
+    uint8_t  hist[PROFILE_HIST_BINS];       // Saturates at 255
+} profile_stat_t;
+
+static profile_stat_t profile_stats[PROF_SECTIONS];
+volatile uint32_t Profile_Window;
+
+static const char profile_names[PROF_SECTIONS][8] PROGMEM = {
+    "solve", "commit", "screen", "isr_t0", "isr_adc"
+};
+
+/** \brief Add one measurement; safe from ISRs and the main loop */
+void Profile_Record(profile_section_t section, uint16_t ticks)
+{
+    profile_stat_t *s = &profile_stats[section];
+    uint8_t bin = 0;
+    uint16_t v = ticks;
+    uint8_t sreg = SREG;
+
+    while (v >>= 2) bin++;
+
+    cli();
+    if (s->count == 0 || ticks < s->min) s->min = ticks;
+    if (ticks > s->max) s->max = ticks;
+    if (s->count != 0xFFFF) {
+        s->count++;
+        s->sum += ticks;
+    }
+    if (s->hist[bin] != 0xFF) s->hist[bin]++;
+    SREG = sreg;
+}
+
+void Profile_Reset(void)
+{
+    uint8_t sreg = SREG;
+
+    cli();
+    memset(profile_stats, 0, sizeof(profile_stats));
+    Profile_Window = 0;
+    SREG = sreg;
+}
+
+typedef void (*profile_write_t)(const uint8_t *data, uint8_t len);
+
+// Flash string, copied through a small stack buffer
+static void Profile_Puts_P(profile_write_t write, const char *str)
+{
+    char buf[8];
+    uint8_t n;
+
+    while ((n = (uint8_t)strlen_P(str)) != 0) {
+        if (n > sizeof(buf)) n = sizeof(buf);
+        memcpy_P(buf, str, n);
+        write((const uint8_t *)buf, n);
+        str += n;
+    }
+}
+
+// "<label><value>", label in flash; the dump goes out one field at a time
+static void Profile_Field(profile_write_t write, const char *label, uint32_t value)
+{
+    char buf[10];
+    uint8_t i = sizeof(buf);
+
+    Profile_Puts_P(write, label);
+    do { buf[--i] = '0' + (value % 10); value /= 10; } while (value);
+    write((const uint8_t *)&buf[i], (uint8_t)(sizeof(buf) - i));
+}
+
+/** \brief Text dump, cycles for min/max/mean, one histogram line per section
+ *
+ *  load is the section's share of the CPU since the reset in 0.01 %
+ *  (0 without PROFILE_TICK()); it only counts while n has not saturated.
+ */
+void Profile_Dump(profile_write_t write)
+{
+    uint8_t i, b;
+
+    for (i = 0; i < PROF_SECTIONS; i++) {
+        profile_stat_t s;
+        uint32_t window;
+        uint8_t sreg = SREG;
+
+        cli();
+        s = profile_stats[i];
+        window = Profile_Window;
+        SREG = sreg;
+
+        Profile_Puts_P(write, profile_names[i]);
+        Profile_Field(write, PSTR(" n "), s.count);
+        Profile_Field(write, PSTR(" min "), 8UL * s.min);
+        Profile_Field(write, PSTR(" max "), 8UL * s.max);
+        Profile_Field(write, PSTR(" mean "), s.count ? (8UL * s.sum) / s.count : 0);
+        Profile_Field(write, PSTR(" load "), window ?
+                      (uint32_t)((8ULL * s.sum * 10000ULL) / ((uint64_t)window * PROFILE_TICK_CYCLES)) : 0);
+        Profile_Puts_P(write, PSTR("\r\n"));
+
+        // Two octaves per bin: counts for 0-3, 4-15, 16-63 ... ticks
+        Profile_Puts_P(write, PSTR("  "));
+        for (b = 0; b < PROFILE_HIST_BINS; b++) Profile_Field(write, PSTR(" "), s.hist[b]);
+        Profile_Puts_P(write, PSTR("\r\n"));
+    }
+}
+
+#endif /* PROFILE_ENABLE */
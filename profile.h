@@ -0,0 +1,66 @@
+/**
+ * @file     profile.h
+ * @brief    Hot-path profiler timed by the free-running Timer1
+ * @date     16 October 2026
+ *
+ * Build with PROFILE_ENABLE defined for the whole project (-DPROFILE_ENABLE)
+ * to collect count, min, max and mean per section plus a histogram, in
+ * Timer1 ticks of 8 CPU cycles. Without it PROFILE_BEGIN/PROFILE_END
+ * expand to nothing and profile.c is empty.
+ *
+ *   PROFILE_BEGIN(SOLVE);
+ *   ADF4351_UpdateFrequencyRegisters(...);
+ *   PROFILE_END(SOLVE);
+ *
+ * PROFILE_TICK() in the Timer0 overflow ISR times the window since the
+ * last reset, so the dump can also give each section's share of the CPU.
+ *
+ * Sections measured in the main loop include any ISR that ran meanwhile.
+ * Sections longer than 65535 ticks (47 ms) wrap.
+ *
+ * The statistics take 94 bytes of RAM. To make room on the ATmega8A, a
+ * PROFILE_ENABLE build also halves the UART rings (uart.h) and the sweep
+ * list and hop table (remote.h, hop.h), which is why the symbol has to be
+ * set project-wide rather than in this file.
+ */
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+
+#define PROFILE_HIST_BINS   8               // Bin n: 4^n <= ticks < 4^(n+1), bin 0 also 0
+#define PROFILE_TICK_CYCLES 16384UL         // CPU cycles per PROFILE_TICK() (Timer0 at clk/64)
+
+typedef enum {
+    PROF_SOLVE,                 // ADF4351_UpdateFrequencyRegisters
+    PROF_COMMIT,                // ADF4351_CommitRegisters from the retune scheduler
+    PROF_SCREEN,                // Update_Screen
+    PROF_ISR_TIMER0,            // Encoder and heartbeat
+    PROF_ISR_ADC,               // Keypad
+    PROF_SECTIONS
+} profile_section_t;
+
+#ifdef PROFILE_ENABLE
+
+#include <avr/io.h>
+
+#define PROFILE_BEGIN(sec)  uint16_t prof_t0_##sec = TCNT1
+#define PROFILE_END(sec)    Profile_Record(PROF_##sec, (uint16_t)(TCNT1 - prof_t0_##sec))
+#define PROFILE_TICK()      (Profile_Window++)
+
+extern volatile uint32_t Profile_Window;   // PROFILE_TICK() calls since the last reset
+
+void Profile_Record(profile_section_t section, uint16_t ticks);
+void Profile_Reset(void);
+void Profile_Dump(void (*write)(const uint8_t *data, uint8_t len));   // Field by field
+
+#else
+
+#define PROFILE_BEGIN(sec)
+#define PROFILE_END(sec)
+#define PROFILE_TICK()
+
+#endif /* PROFILE_ENABLE */
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,458 @@
+/**
+ * @file     remote.c
+ * @brief    Serial remote-control protocol (text lines and binary frames)
+ * @date     16 October 2026
+ */
+
+#include <avr/pgmspace.h>
+#include <stdlib.h>
+#include <string.h>
+#include "remote.h"
+#include "profile.h"
+#include "retune.h"
+#include "event.h"
+#include "stack.h"
+
+typedef enum {
+    REMOTE_IDLE,                // Between commands, or inside a text line
+    REMOTE_BIN_CMD,
+    REMOTE_BIN_LEN,
+    REMOTE_BIN_PAYLOAD,
+    REMOTE_BIN_SUM
+} remote_rx_state_t;
+
+// Handler from the flash table
+#define REMOTE_CALL(f)  ((__typeof__(remote->f))pgm_read_ptr(&remote->f))
+
+static const remote_handlers_t *remote;  // In flash
+static remote_rx_state_t remote_state;
+
+// A frame only starts between text lines, so line and payload never hold
+// data at once. A sweep command has read its values out of either before
+// it builds the sweep config here.
+static union {
+    char           line[REMOTE_LINE_MAX + 1];
+    uint8_t        payload[REMOTE_PAYLOAD_MAX];
+    sweep_config_t sweep;
+} remote_buf;
+static uint8_t  remote_line_len;
+static bool     remote_line_overflow;
+
+static uint8_t  remote_cmd, remote_len, remote_pos, remote_sum;
+
+static uint32_t remote_list[REMOTE_LIST_MAX];
+static uint8_t  remote_list_len;
+static bool     remote_sweep_on_lock;   // K: sweeps dwell from lock
+
+// H hands the whole list to Hop_Load()
+_Static_assert(REMOTE_LIST_MAX <= HOP_LIST_MAX, "The remote list must fit the hop table");
+
+// --- Output ---
+// Flash string, copied through a small stack buffer
+static void Remote_Puts_P(const char *str)
+{
+    char buf[8];
+    uint8_t n;
+
+    while ((n = (uint8_t)strlen_P(str)) != 0) {
+        if (n > sizeof(buf)) n = sizeof(buf);
+        memcpy_P(buf, str, n);
+        REMOTE_CALL(write)((const uint8_t *)buf, n);
+        str += n;
+    }
+}
+
+// " <n>": replies are streamed one field at a time, so no reply needs a
+// line-sized buffer on the stack
+static void Remote_PutDec(uint32_t n)
+{
+    char buf[11];
+    uint8_t i = sizeof(buf);
+
+    do { buf[--i] = '0' + (n % 10); n /= 10; } while (n);
+    buf[--i] = ' ';
+    REMOTE_CALL(write)((const uint8_t *)&buf[i], (uint8_t)(sizeof(buf) - i));
+}
+
+static void Remote_SendFrame(uint8_t cmd, const uint8_t *payload, uint8_t len)
+{
+    uint8_t head[3] = { REMOTE_SYNC, cmd, len };
+    uint8_t sum = cmd + len;
+    uint8_t i;
+
+    for (i = 0; i < len; i++) sum += payload[i];
+    sum = (uint8_t)-sum;
+    REMOTE_CALL(write)(head, 3);
+    if (len) REMOTE_CALL(write)(payload, len);
+    REMOTE_CALL(write)(&sum, 1);
+}
+
+static void Remote_Nak(uint8_t cmd, remote_err_t err)
+{
+    uint8_t payload[2] = { cmd, (uint8_t)err };
+
+    Remote_SendFrame(REMOTE_NAK, payload, 2);
+}
+
+static uint32_t Remote_GetU32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void Remote_PutU32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+// --- Commands shared by both framings ---
+
+// A running list sweep or hop reads remote_list in place, so L must wait for it
+static bool Remote_ListBusy(void)
+{
+    remote_state_t st;
+
+    REMOTE_CALL(query)(&st);
+    return st.list_busy;
+}
+
+static remote_err_t Remote_ListAppend(uint32_t khz)
+{
+    if (khz < ADF4351_RFOUTMIN || khz > ADF4351_RFOUT_MAX) return REMOTE_ERR_RANGE;
+    if (remote_list_len >= REMOTE_LIST_MAX) return REMOTE_ERR_FULL;
+    remote_list[remote_list_len++] = khz;
+    return REMOTE_OK;
+}
+
+static remote_err_t Remote_Sweep(sweep_mode_t mode, bool once, uint32_t dwell_us,
+                                 bool list, uint32_t start, uint32_t stop, uint32_t step)
+{
+    sweep_config_t *cfg = &remote_buf.sweep;
+
+    if (mode > SWEEP_TRIANGLE) return REMOTE_ERR_RANGE;
+    if (list && !remote_list_len) return REMOTE_ERR_RANGE;
+    if (!list && (start < ADF4351_RFOUTMIN || stop > ADF4351_RFOUT_MAX || stop < start || !step))
+        return REMOTE_ERR_RANGE;
+
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->source   = list ? SWEEP_SRC_LIST : SWEEP_SRC_LINEAR;
+    cfg->mode     = mode;
+    cfg->once     = once;
+    cfg->on_lock  = remote_sweep_on_lock;
+    cfg->dwell_us = dwell_us;
+    if (list) {
+        cfg->list_khz = remote_list;
+        cfg->list_len = remote_list_len;
+    } else {
+        cfg->start_khz = start;
+        cfg->stop_khz  = stop;
+        cfg->step_khz  = step;
+    }
+    return REMOTE_CALL(sweep_start)(cfg);
+}
+
+static remote_err_t Remote_Hop(hop_trigger_t trigger, uint32_t period_us)
+{
+    if (trigger > HOP_TRIG_INT1) return REMOTE_ERR_RANGE;
+    if (!remote_list_len) return REMOTE_ERR_RANGE;
+    return REMOTE_CALL(hop_start)(remote_list, remote_list_len, trigger, period_us);
+}
+
+// --- Text ---
+static bool Remote_NextU32(char **p, uint8_t base, uint32_t *value)
+{
+    char *end;
+
+    while (**p == ' ') (*p)++;
+    if (!**p) return false;
+    *value = strtoul(*p, &end, base);
+    if (end == *p) return false;
+    *p = end;
+    return true;
+}
+
+static void Remote_Query(void)
+{
+    remote_state_t st;
+
+    REMOTE_CALL(query)(&st);
+    Remote_Puts_P(PSTR("F"));   Remote_PutDec(st.freq_khz);
+    Remote_Puts_P(PSTR(" O"));  Remote_PutDec(st.output_on);
+    Remote_Puts_P(PSTR(" W"));  Remote_PutDec(st.sweeping);
+    Remote_Puts_P(PSTR(" N"));  Remote_PutDec(remote_list_len);
+    Remote_Puts_P(PSTR(" V"));  Remote_PutDec(st.overruns);
+    Remote_Puts_P(PSTR(" H"));  Remote_PutDec(st.hop_latency_ns);
+    Remote_Puts_P(PSTR("\r\n"));
+}
+
+static remote_err_t Remote_ExecLine(char *line)
+{
+    char *p = line + 1;
+    uint32_t v[6];                      // R takes up to six words, W four values
+    uint8_t n;
+
+    switch (line[0]) {
+    case 'F': case 'f':
+        if (!Remote_NextU32(&p, 10, &v[0])) return REMOTE_ERR_LENGTH;
+        return REMOTE_CALL(set_freq)(v[0]);
+
+    case 'O': case 'o':
+        if (!Remote_NextU32(&p, 10, &v[0]) || v[0] > 1) return REMOTE_ERR_RANGE;
+        return REMOTE_CALL(set_output)(v[0] != 0);
+
+    case 'R': case 'r':
+        for (n = 0; n < 6 && Remote_NextU32(&p, 16, &v[n]); n++) ;
+        if (!n) return REMOTE_ERR_LENGTH;
+        return REMOTE_CALL(set_regs)(v, n);
+
+    case 'L': case 'l':
+        if (Remote_ListBusy()) return REMOTE_ERR_BUSY;
+        if (!Remote_NextU32(&p, 10, &v[0])) {
+            remote_list_len = 0;
+            return REMOTE_OK;
+        }
+        do {
+            remote_err_t err = Remote_ListAppend(v[0]);
+            if (err != REMOTE_OK) return err;
+        } while (Remote_NextU32(&p, 10, &v[0]));
+        return REMOTE_OK;
+
+    case 'W': case 'w':
+        if (*p == 'L' || *p == 'l') {
+            p++;
+            if (!Remote_NextU32(&p, 10, &v[0])) return REMOTE_ERR_LENGTH;
+            return Remote_Sweep(SWEEP_UP, false, v[0], true, 0, 0, 0);
+        }
+        for (n = 0; n < 4; n++)
+            if (!Remote_NextU32(&p, 10, &v[n])) return REMOTE_ERR_LENGTH;
+        return Remote_Sweep(SWEEP_UP, false, v[3], false, v[0], v[1], v[2]);
+
+    case 'H': case 'h':
+        if (*p == 'E' || *p == 'e') {
+            p++;
+            if (!Remote_NextU32(&p, 10, &v[0]) || v[0] > 1) return REMOTE_ERR_RANGE;
+            return Remote_Hop(v[0] ? HOP_TRIG_INT1 : HOP_TRIG_INT0, 0);
+        }
+        if (!Remote_NextU32(&p, 10, &v[0])) return REMOTE_ERR_LENGTH;
+        return Remote_Hop(HOP_TRIG_TIMER, v[0]);
+
+    case 'X': case 'x':
+        REMOTE_CALL(sweep_stop)();
+        return REMOTE_OK;
+
+    case 'K': case 'k':
+        if (!Remote_NextU32(&p, 10, &v[0]) || v[0] > 1) return REMOTE_ERR_RANGE;
+        remote_sweep_on_lock = (v[0] != 0);
+        return REMOTE_OK;
+
+    case '?':
+        Remote_Query();
+        return REMOTE_OK;
+
+    case 'T': case 't':
+        Remote_Puts_P(PSTR("T"));
+        Remote_PutDec(Retune_Stats.requests);
+        Remote_PutDec(Retune_Stats.superseded);
+        Remote_PutDec(Retune_Stats.solves);
+        Remote_PutDec(Retune_Stats.commits);
+        Remote_PutDec(Retune_Stats.unchanged);
+        Remote_PutDec(Retune_Stats.words);
+        Remote_PutDec(HOP_TICKS_TO_NS(Retune_Stats.lock_last) / 1000);
+        Remote_PutDec(HOP_TICKS_TO_NS(Retune_Stats.lock_max) / 1000);
+        Remote_PutDec(Retune_Stats.lock_timeouts);
+        Remote_PutDec(Retune_Stats.bandsel_ns / 1000);
+        Remote_PutDec(Retune_Stats.bandsel_skips);
+        Remote_Puts_P(PSTR("\r\n"));
+        return REMOTE_OK;
+
+    case 'I': case 'i': {
+        // Idle share first: the writes below are part of the next window
+        uint16_t idle = Event_IdlePermille();
+        uint32_t wakes = Event_Stats.wakes, passes = Event_Stats.passes;
+        Event_ResetStats();
+        Remote_Puts_P(PSTR("I"));
+        Remote_PutDec(idle);
+        Remote_PutDec(wakes);
+        Remote_PutDec(passes);
+        Remote_Puts_P(PSTR("\r\n"));
+        return REMOTE_OK;
+    }
+
+    case 'M': case 'm':
+        Remote_Puts_P(PSTR("M"));
+        Remote_PutDec(Stack_Gap());
+        Remote_PutDec(Stack_Unused());
+        Remote_Puts_P(PSTR("\r\n"));
+        return REMOTE_OK;
+
+#ifdef PROFILE_ENABLE
+    case 'P': case 'p':
+        if (*p == '0') Profile_Reset();
+        else           Profile_Dump(REMOTE_CALL(write));
+        return REMOTE_OK;
+#endif
+    }
+    return REMOTE_ERR_UNKNOWN;
+}
+
+static void Remote_EndLine(void)
+{
+    remote_err_t err;
+    char cmd = remote_buf.line[0];          // A sweep command reuses the buffer
+
+    remote_buf.line[remote_line_len] = '\0';
+    if (remote_line_overflow) err = REMOTE_ERR_LENGTH;
+    else                      err = Remote_ExecLine(remote_buf.line);
+
+    if (err == REMOTE_OK) {
+        if (cmd != '?' && cmd != 'T' && cmd != 't') Remote_Puts_P(PSTR("OK\r\n"));
+    } else {
+        Remote_Puts_P(PSTR("ERR"));
+        Remote_PutDec(err);
+        Remote_Puts_P(PSTR("\r\n"));
+    }
+    remote_line_len = 0;
+    remote_line_overflow = false;
+}
+
+// --- Binary ---
+static remote_err_t Remote_ExecFrame(void)
+{
+    const uint8_t *p = remote_buf.payload;
+    uint8_t i;
+
+    switch (remote_cmd) {
+    case REMOTE_CMD_FREQ:
+        if (remote_len != 4) return REMOTE_ERR_LENGTH;
+        return REMOTE_CALL(set_freq)(Remote_GetU32(p));
+
+    case REMOTE_CMD_OUTPUT:
+        if (remote_len != 1) return REMOTE_ERR_LENGTH;
+        return REMOTE_CALL(set_output)(p[0] != 0);
+
+    case REMOTE_CMD_REGS: {
+        uint32_t words[6];
+        if (!remote_len || remote_len > 24 || (remote_len & 3)) return REMOTE_ERR_LENGTH;
+        for (i = 0; i < remote_len / 4; i++) words[i] = Remote_GetU32(p + 4 * i);
+        return REMOTE_CALL(set_regs)(words, remote_len / 4);
+    }
+
+    case REMOTE_CMD_LIST:
+        if (remote_len & 3) return REMOTE_ERR_LENGTH;
+        if (Remote_ListBusy()) return REMOTE_ERR_BUSY;
+        if (!remote_len) remote_list_len = 0;
+        for (i = 0; i < remote_len; i += 4) {
+            remote_err_t err = Remote_ListAppend(Remote_GetU32(p + i));
+            if (err != REMOTE_OK) return err;
+        }
+        return REMOTE_OK;
+
+    case REMOTE_CMD_SWEEP:
+        if (remote_len == 6)
+            return Remote_Sweep((sweep_mode_t)p[0], p[1] != 0, Remote_GetU32(p + 2),
+                                true, 0, 0, 0);
+        if (remote_len == 18)
+            return Remote_Sweep((sweep_mode_t)p[0], p[1] != 0, Remote_GetU32(p + 2), false,
+                                Remote_GetU32(p + 6), Remote_GetU32(p + 10), Remote_GetU32(p + 14));
+        return REMOTE_ERR_LENGTH;
+
+    case REMOTE_CMD_STOP:
+        REMOTE_CALL(sweep_stop)();
+        return REMOTE_OK;
+
+    case REMOTE_CMD_HOP:
+        if (remote_len != 5) return REMOTE_ERR_LENGTH;
+        return Remote_Hop((hop_trigger_t)p[0], Remote_GetU32(p + 1));
+
+    case REMOTE_CMD_QUERY: {
+        remote_state_t st;
+        uint8_t reply[13];
+        REMOTE_CALL(query)(&st);
+        Remote_PutU32(reply, st.freq_khz);
+        reply[4] = (st.output_on ? 0x01 : 0) | (st.sweeping ? 0x02 : 0);
+        reply[5] = (uint8_t)st.overruns;
+        reply[6] = (uint8_t)(st.overruns >> 8);
+        reply[7] = (uint8_t)remote_list_len;
+        reply[8] = 0;                       // List length high byte
+        Remote_PutU32(reply + 9, st.hop_latency_ns);
+        Remote_SendFrame(REMOTE_CMD_QUERY | REMOTE_REPLY, reply, sizeof(reply));
+        return REMOTE_OK;
+    }
+    }
+    return REMOTE_ERR_UNKNOWN;
+}
+
+// --- Public ---
+/** \brief Reset the parser; handlers must be a PROGMEM table */
+void Remote_Init(const remote_handlers_t *handlers)
+{
+    remote = handlers;
+    remote_state = REMOTE_IDLE;
+    remote_line_len = 0;
+    remote_line_overflow = false;
+    remote_list_len = 0;
+    remote_sweep_on_lock = false;
+}
+
+/** \brief Feed one received byte; complete commands run immediately */
+void Remote_Feed(uint8_t data)
+{
+    remote_err_t err;
+
+    switch (remote_state) {
+    case REMOTE_IDLE:
+        // 1. Sync byte starts a frame only between text lines
+        if (data == REMOTE_SYNC && remote_line_len == 0) {
+            remote_state = REMOTE_BIN_CMD;
+        } else if (data == '\r' || data == '\n') {
+            if (remote_line_len || remote_line_overflow) Remote_EndLine();
+        } else if (remote_line_len < REMOTE_LINE_MAX) {
+            remote_buf.line[remote_line_len++] = (char)data;
+        } else {
+            remote_line_overflow = true;
+        }
+        break;
+
+    case REMOTE_BIN_CMD:
+        remote_cmd = data;
+        remote_sum = data;
+        remote_state = REMOTE_BIN_LEN;
+        break;
+
+    case REMOTE_BIN_LEN:
+        // 2. Oversized frames are rejected before their payload is read
+        if (data > REMOTE_PAYLOAD_MAX) {
+            Remote_Nak(remote_cmd, REMOTE_ERR_LENGTH);
+            remote_state = REMOTE_IDLE;
+            break;
+        }
+        remote_len = data;
+        remote_sum += data;
+        remote_pos = 0;
+        remote_state = data ? REMOTE_BIN_PAYLOAD : REMOTE_BIN_SUM;
+        break;
+
+    case REMOTE_BIN_PAYLOAD:
+        remote_buf.payload[remote_pos++] = data;
+        remote_sum += data;
+        if (remote_pos == remote_len) remote_state = REMOTE_BIN_SUM;
+        break;
+
+    case REMOTE_BIN_SUM:
+        // 3. Verified frames run at once, no acknowledge unless they fail
+        remote_state = REMOTE_IDLE;
+        if ((uint8_t)(remote_sum + data) != 0) {
+            Remote_Nak(remote_cmd, REMOTE_ERR_CHECKSUM);
+            break;
+        }
+        err = Remote_ExecFrame();
+        if (err != REMOTE_OK) Remote_Nak(remote_cmd, err);
+        break;
+    }
+}
+
+uint16_t Remote_ListLen(void)
+{
+    return remote_list_len;
+}
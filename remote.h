@@ -0,0 +1,108 @@
+/**
+ * @file     remote.h
+ * @brief    Serial remote-control protocol (text lines and binary frames)
+ * @date     16 October 2026
+ *
+ * The parser is fed one byte at a time and calls back into the
+ * application through a remote_handlers_t table in flash (PROGMEM), so it
+ * has no hardware dependencies. Both framings can be mixed on the same link:
+ *
+ * Text, one command per line (CR or LF), answered with "OK" or "ERR n":
+ *   F <kHz>                        set frequency
+ *   O <0|1>                        RF output off/on
+ *   R <hex> [<hex>...]             raw register words (address in bits 2:0)
+ *   L [<kHz>...]                   append to the sweep list, no value clears it;
+ *                                  values outside 35000-4400000 are refused,
+ *                                  and so is any change while a WL sweep or
+ *                                  a hop reads the list (ERR 6)
+ *   W <start> <stop> <step> <us>   linear sweep, up, repeating
+ *   WL <us>                        sweep over the uploaded list
+ *   H <us>                         hop over the uploaded list every <us>
+ *   HE <0|1>                       hop over the list on INT0/INT1 rising edges
+ *   X                              stop sweep or hop
+ *   K <0|1>                        sweeps started afterwards dwell from PLL lock
+ *   ?                              state: "F <kHz> O <0|1> W <0|1> N <list> V <overruns> H <ns>"
+ *                                  H is the worst hop latency so far
+ *   T                              retune counters: "T <requests> <superseded>
+ *                                  <solves> <commits> <unchanged> <words>
+ *                                  <lock us> <worst lock us> <lock timeouts>
+ *                                  <band select us> <band select skips>"
+ *   I                              main loop load since the last I: "I <idle
+ *                                  permille> <wakes> <passes>"
+ *   M                              RAM: "M <stack gap> <never used>", bytes
+ *                                  between the globals and RAMEND, and how
+ *                                  many of them the stack has not reached
+ *   P / P0                         profiler dump / reset (PROFILE_ENABLE builds)
+ *
+ * Binary frame: REMOTE_SYNC, cmd, len, payload[len], sum, where sum makes
+ * cmd + len + payload + sum == 0 (mod 256). Integers are little-endian.
+ * Binary commands are not acknowledged, so a host can stream them without
+ * waiting; only failures (REMOTE_NAK) and queries produce a reply frame.
+ */
+
+#ifndef REMOTE_H_
+#define REMOTE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sweep.h"
+#include "hop.h"
+
+#define REMOTE_SYNC             0xA5
+#define REMOTE_LINE_MAX         48      // Text line, without terminator
+#define REMOTE_PAYLOAD_MAX      32      // Binary payload
+#ifdef PROFILE_ENABLE                   // Room for the statistics (profile.h)
+#define REMOTE_LIST_MAX         4
+#else
+#define REMOTE_LIST_MAX         8       // Uploaded sweep list entries, one hop table
+#endif
+
+// Binary commands
+#define REMOTE_CMD_FREQ         0x01    // u32 kHz
+#define REMOTE_CMD_OUTPUT       0x02    // u8 on
+#define REMOTE_CMD_REGS         0x03    // 1..6 x u32 raw register word
+#define REMOTE_CMD_LIST         0x04    // 0..8 x u32 kHz appended; len 0 clears
+#define REMOTE_CMD_SWEEP        0x05    // u8 mode, u8 once, u32 dwell_us [, u32 start, stop, step]
+#define REMOTE_CMD_STOP         0x06    // -
+#define REMOTE_CMD_QUERY        0x07    // - ; reply REMOTE_CMD_QUERY | REMOTE_REPLY
+#define REMOTE_CMD_HOP          0x08    // u8 trigger (hop_trigger_t), u32 period_us
+#define REMOTE_REPLY            0x80
+#define REMOTE_NAK              0x7F    // Reply payload: u8 cmd, u8 error
+
+typedef enum {
+    REMOTE_OK = 0,
+    REMOTE_ERR_CHECKSUM,
+    REMOTE_ERR_LENGTH,
+    REMOTE_ERR_RANGE,
+    REMOTE_ERR_UNKNOWN,
+    REMOTE_ERR_FULL,
+    REMOTE_ERR_BUSY             // The list is in use by a running sweep or hop
+} remote_err_t;
+
+typedef struct {
+    uint32_t freq_khz;
+    bool     output_on;
+    bool     sweeping;
+    bool     list_busy;         // A running sweep or hop reads the uploaded list
+    uint16_t overruns;
+    uint32_t hop_latency_ns;    // Worst hop since the last start
+} remote_state_t;
+
+// Application side; handlers return REMOTE_OK or an error code
+typedef struct {
+    remote_err_t (*set_freq)(uint32_t khz);
+    remote_err_t (*set_output)(bool on);
+    remote_err_t (*set_regs)(const uint32_t *words, uint8_t count);
+    remote_err_t (*sweep_start)(sweep_config_t *config);   // May fill in refin/spacing
+    remote_err_t (*hop_start)(const uint32_t *list_khz, uint8_t count,
+                              hop_trigger_t trigger, uint32_t period_us);
+    void         (*sweep_stop)(void);
+    void         (*query)(remote_state_t *state);
+    void         (*write)(const uint8_t *data, uint8_t len);
+} remote_handlers_t;
+
+void     Remote_Init(const remote_handlers_t *handlers);
+void     Remote_Feed(uint8_t data);
+uint16_t Remote_ListLen(void);
+
+#endif /* REMOTE_H_ */
@@ -0,0 +1,152 @@
+/**
+ * @file     retune.c
+ * @brief    Latest-wins retune scheduler for the ADF4351
+ * @date     16 October 2026
+ */
+
+#ifndef F_CPU
+#define F_CPU 11059200UL
+#endif
+
+#include <avr/io.h>
+#include <util/delay.h>
+#include "retune.h"
+#include "adf4351.h"
+#include "sweep.h"
+#include "hop.h"
+#include "profile.h"
+
+#define RETUNE_LOCK_TIMEOUT_TICKS \
+    ((uint16_t)(((uint64_t)RETUNE_LOCK_TIMEOUT_US * SWEEP_TIMER_HZ) / 1000000UL))
+
+static uint32_t retune_refin_hz;
+static uint32_t retune_spacing_hz;
+static uint32_t retune_target_khz;
+static bool     retune_output_on;
+static bool     retune_pending;
+static uint32_t retune_solved_khz;      // Frequency in the shadows, 0 if unknown
+static ADF4351_FreqWords_t retune_words;
+static bool     retune_has_words;       // retune_words hold the pending target
+
+retune_stats_t Retune_Stats;
+
+void Retune_Init(uint32_t refin_hz, uint32_t spacing_hz)
+{
+    retune_refin_hz = refin_hz;
+    retune_spacing_hz = spacing_hz;
+    retune_pending = false;
+    retune_solved_khz = 0;
+}
+
+/** \brief Ask for a frequency and output state; replaces any pending post */
+void Retune_Post(uint32_t khz, bool output_on)
+{
+    Retune_Stats.requests++;
+    if (retune_pending) Retune_Stats.superseded++;
+    retune_target_khz = khz;
+    retune_output_on = output_on;
+    retune_has_words = false;
+    retune_pending = true;
+}
+
+/** \brief Post with words solved earlier for khz; the service loads them */
+void Retune_PostWords(uint32_t khz, const ADF4351_FreqWords_t *words, bool output_on)
+{
+    Retune_Post(khz, output_on);
+    retune_words = *words;
+    retune_has_words = true;
+}
+
+/** \brief Shadows were changed behind the scheduler (sweep, hop, raw words)
+ *
+ *  Drops any pending post and forces the next one through the solver.
+ */
+void Retune_Invalidate(void)
+{
+    retune_pending = false;
+    retune_solved_khz = 0;
+    ADF4351_ForceBandSelect();
+}
+
+/** \brief The shadows already hold khz (ADF4351_LoadPreset); skip its solve */
+void Retune_Loaded(uint32_t khz)
+{
+    retune_pending = false;
+    retune_solved_khz = khz;
+}
+
+bool Retune_Pending(void)
+{
+    return retune_pending;
+}
+
+/** \brief Frequency the shadows hold, 0 if unknown */
+uint32_t Retune_SolvedKHz(void)
+{
+    return retune_solved_khz;
+}
+
+// Poll LD after a commit and record the write-to-lock time
+static void Retune_WaitLock(void)
+{
+    uint16_t start = TCNT1;
+    uint16_t waited;
+
+    _delay_us(RETUNE_LD_BLANK_US);
+    for (;;) {
+        waited = TCNT1 - start;
+        if (ADF4351_Locked()) break;
+        if (waited >= RETUNE_LOCK_TIMEOUT_TICKS) {
+            Retune_Stats.lock_timeouts++;
+            return;
+        }
+        _delay_us(2);
+    }
+    Retune_Stats.lock_last = waited;
+    if (waited > Retune_Stats.lock_max) Retune_Stats.lock_max = waited;
+}
+
+/** \brief Main loop hook: apply the newest post; returns the words sent */
+uint8_t Retune_Service(void)
+{
+    uint8_t sent;
+    bool    relock;
+
+    if (!retune_pending || Sweep_Running() || Hop_Running()) return 0;
+    retune_pending = false;
+
+    // 1. Solve (or load) only when the frequency moved; big jumps arm fast lock
+    if (retune_target_khz != retune_solved_khz) {
+        uint32_t jump = (retune_target_khz > retune_solved_khz) ?
+                        retune_target_khz - retune_solved_khz : retune_solved_khz - retune_target_khz;
+
+        if (retune_has_words) {
+            ADF4351_LoadFrequencyWords(retune_target_khz, &retune_words, retune_refin_hz);
+        } else {
+            PROFILE_BEGIN(SOLVE);
+            ADF4351_UpdateFrequencyRegisters(retune_target_khz, retune_refin_hz,
+                                             retune_spacing_hz, 0, 1, 0);
+            PROFILE_END(SOLVE);
+            Retune_Stats.solves++;
+        }
+        Retune_Stats.bandsel_ns = ADF4351_BandSelectTimeNs(retune_refin_hz);
+        if (!Retune_Stats.bandsel_ns) Retune_Stats.bandsel_skips++;
+        ADF4351_SetFastLock(jump >= RETUNE_FASTLOCK_KHZ ? RETUNE_FASTLOCK_US : 0, retune_refin_hz);
+        retune_solved_khz = retune_target_khz;
+    }
+    ADF4351_Reg4.b.OutEnable = retune_output_on ? 1 : 0;
+
+    // 2. The driver diff sends only what changed; R0-R2 mean an R0 write
+    relock = (ADF4351_DirtyMask() & 0x07) != 0;
+    PROFILE_BEGIN(COMMIT);
+    sent = ADF4351_CommitRegisters();
+    PROFILE_END(COMMIT);
+    if (sent) {
+        Retune_Stats.commits++;
+        Retune_Stats.words += sent;
+        if (relock && ADF4351_HasLockDetect()) Retune_WaitLock();
+    } else {
+        Retune_Stats.unchanged++;
+    }
+    return sent;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file     retune.h
+ * @brief    Latest-wins retune scheduler for the ADF4351
+ * @date     16 October 2026
+ *
+ * Keys, the encoder and remote commands post a target (frequency and RF
+ * output state); Retune_Service() in the main loop solves only the newest
+ * one and commits only the registers that changed. A post that arrives
+ * before the previous one was serviced replaces it. Nothing is committed
+ * while a sweep or hop list owns the shadows; the post stays pending.
+ *
+ * When the transport can read the lock-detect pin, every commit waits for
+ * lock and the time from the last latched word to lock is recorded in
+ * Timer1 ticks (SWEEP_TIMER_HZ). Jumps of RETUNE_FASTLOCK_KHZ or more can
+ * arm the chip's fast-lock timer; that needs the SW1/SW2 switch wired to
+ * the loop filter, so it is off unless RETUNE_FASTLOCK_US is defined.
+ *
+ * A post can carry words solved earlier (stored channels); those are loaded
+ * instead of solved.
+ *
+ * Solves run with the automatic band select clock, so small steps skip
+ * the VCO band select; bandsel_ns is what the last solve left in the lock
+ * time (0 when skipped).
+ */
+
+#ifndef RETUNE_H_
+#define RETUNE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "adf4351.h"
+
+#ifndef RETUNE_FASTLOCK_US
+#define RETUNE_FASTLOCK_US      0           // Fast-lock timeout, 0 = off
+#endif
+#define RETUNE_FASTLOCK_KHZ     10000UL     // Smallest jump that arms fast lock
+#define RETUNE_LOCK_TIMEOUT_US  2000UL      // Give up waiting for LD after this
+#define RETUNE_LD_BLANK_US      2           // LD may still show the old lock right after R0
+
+typedef struct {
+    uint16_t requests;          // Posts received
+    uint16_t superseded;        // Posts replaced before they were serviced
+    uint16_t solves;            // Solver runs
+    uint16_t commits;           // Services that sent at least one word
+    uint16_t unchanged;         // Services that had nothing to send
+    uint32_t words;             // Register words sent
+    uint16_t lock_last;         // Last write-to-lock time, Timer1 ticks
+    uint16_t lock_max;          // Worst write-to-lock time, Timer1 ticks
+    uint16_t lock_timeouts;     // Commits that saw no lock within the timeout
+    uint32_t bandsel_ns;        // Band select time of the last solve, 0 if skipped
+    uint16_t bandsel_skips;     // Solves that skipped the band select
+} retune_stats_t;
+
+extern retune_stats_t Retune_Stats;
+
+void    Retune_Init(uint32_t refin_hz, uint32_t spacing_hz);
+void    Retune_Post(uint32_t khz, bool output_on);
+void    Retune_PostWords(uint32_t khz, const ADF4351_FreqWords_t *words, bool output_on);
+void    Retune_Invalidate(void);
+void    Retune_Loaded(uint32_t khz);
+bool    Retune_Pending(void);
+uint32_t Retune_SolvedKHz(void);
+uint8_t Retune_Service(void);
+
+#endif /* RETUNE_H_ */
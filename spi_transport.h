@@ -0,0 +1,41 @@
+/**
+ * @file     spi_transport.h
+ * @brief    SPI transport interface used by the ADF4351 driver
+ * @date     16 October 2026
+ *
+ * The driver only needs chip-enable, byte transfer and chip-disable (LE
+ * rising edge latches the word). A backend that has the LD (or MUXOUT)
+ * pin wired can also report its level. Each backend exposes one of these
+ * tables: soft_spi_transport for the AVR bit-bang, host_spi_transport for
+ * the Linux recording backend in host/. soft_spi_bus and host_spi_bus
+ * drive several devices bit-parallel for ADF4351_CommitGroup().
+ */
+
+#ifndef SPI_TRANSPORT_H_
+#define SPI_TRANSPORT_H_
+
+#include <stdint.h>
+
+typedef struct {
+    void (*init)(void);
+    void (*chip_enable)(void);
+    void (*transfer)(uint8_t data);
+    void (*chip_disable)(void);
+    void (*write32)(uint32_t word);     // Optional: whole latched word, NULL if absent
+    uint8_t (*lock_detect)(void);       // Optional: lock-detect pin level, NULL if not wired
+} spi_transport_t;
+
+/** \brief Bit-parallel bus: one shared CLK, a DATA and an LE pin per lane
+ *
+ *  write32 shifts words[i] into every lane i in lane_mask at once and
+ *  latches them all on one LE edge; lanes outside the mask keep LE high.
+ *  Lanes may share an LE pin: le_group widens a mask to every lane whose
+ *  LE moves with it (NULL when each lane has its own LE).
+ */
+typedef struct {
+    uint8_t lanes;
+    void    (*write32)(const uint32_t *words, uint8_t lane_mask);
+    uint8_t (*le_group)(uint8_t lane_mask);
+} spi_bus_t;
+
+#endif /* SPI_TRANSPORT_H_ */
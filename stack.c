@@ -0,0 +1,55 @@
+/**
+ * @file     stack.c
+ * @brief    Stack high-water mark from a canary painted at boot
+ * @date     16 October 2026
+ */
+
+#include <avr/io.h>
+#include "stack.h"
+
+extern uint8_t __heap_start[];              // Linker: first byte after .bss/.noinit
+
+void Stack_Paint(void) __attribute__((naked, used, section(".init1")));
+
+/** \brief Fill __heap_start..RAMEND with the canary
+ *
+ *  Runs from .init1, before SP and r1 are set up, so it only touches
+ *  r24, r25 and Z and has no C prologue. The bound is tested before the
+ *  first store, so globals that reach RAMEND leave nothing to paint.
+ */
+void Stack_Paint(void)
+{
+    __asm__ volatile (
+        "    ldi  r30, lo8(__heap_start)  \n"
+        "    ldi  r31, hi8(__heap_start)  \n"
+        "    ldi  r24, %[canary]          \n"
+        "    ldi  r25, hi8(%[end])        \n"
+        "    rjmp 2f                      \n"
+        "1:  st   Z+, r24                 \n"
+        "2:  cpi  r30, lo8(%[end])        \n"
+        "    cpc  r31, r25                \n"
+        "    brlo 1b                      \n"
+        "    breq 1b                      \n"
+        :
+        : [canary] "M" (STACK_CANARY), [end] "i" (RAMEND)
+    );
+}
+
+/** \brief Bytes between the globals and RAMEND, the most the stack can use
+ *
+ *  0 when the globals run past RAMEND; stack.ld refuses to link that.
+ */
+uint16_t Stack_Gap(void)
+{
+    if ((uint16_t)(uintptr_t)__heap_start > RAMEND) return 0;
+    return (uint16_t)(RAMEND + 1 - (uint16_t)(uintptr_t)__heap_start);
+}
+
+/** \brief Bytes at the bottom of the gap the stack has never written */
+uint16_t Stack_Unused(void)
+{
+    const uint8_t *p = __heap_start;
+
+    while (p <= (const uint8_t *)RAMEND && *p == STACK_CANARY) p++;
+    return (uint16_t)(p - __heap_start);
+}
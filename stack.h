@@ -0,0 +1,31 @@
+/**
+ * @file     stack.h
+ * @brief    Stack high-water mark from a canary painted at boot
+ * @date     16 October 2026
+ *
+ * Before the C runtime sets up the stack (.init1), every byte between the
+ * end of the globals (__heap_start; nothing uses malloc) and RAMEND is
+ * filled with STACK_CANARY. The stack grows down from RAMEND, so the
+ * canary bytes still intact at the bottom of the gap are RAM the stack
+ * has never reached. Stack_Gap() - Stack_Unused() is the deepest the
+ * stack has been since reset, ISRs included. stack.ld fails the link when
+ * the gap would be smaller than STACK_RESERVE.
+ *
+ * Stack_Unused() scans up from the globals and stops at the first
+ * overwritten byte; a local that happens to hold STACK_CANARY at the
+ * deepest point can make it over-report by a few bytes.
+ *
+ * Target only: the host simulation stubs both calls out (host/sim/sim.c).
+ */
+
+#ifndef STACK_H_
+#define STACK_H_
+
+#include <stdint.h>
+
+#define STACK_CANARY    0xC5
+
+uint16_t Stack_Gap(void);
+uint16_t Stack_Unused(void);
+
+#endif /* STACK_H_ */
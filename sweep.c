@@ -0,0 +1,292 @@
+/**
+ * @file     sweep.c
+ * @brief    Timer1 driven frequency sweep engine
+ * @date     16 October 2026
+ */
+
+#ifndef F_CPU
+#define F_CPU 11059200UL
+#endif
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "sweep.h"
+#include "adf4351.h"
+#include "event.h"
+
+#define SWEEP_STAGE_SYNC    0x01    // First step of a pass
+#define SWEEP_STAGE_LAST    0x02    // Last step of a single pass
+
+// Compare chunks longer than this are split so the remainder never gets
+// so short that OCR1A would be set behind TCNT1
+#define SWEEP_MAX_CHUNK     0x8000U
+
+#define SWEEP_US_TO_TICKS(us)   ((uint16_t)(((uint64_t)(us) * SWEEP_TIMER_HZ) / 1000000UL))
+
+static sweep_config_t   sweep_cfg;
+static uint16_t         sweep_count;        // Points in the plan
+static uint16_t         sweep_pos;          // Plan position of the staged point
+static int8_t           sweep_dir;
+static uint32_t         sweep_dwell_ticks;
+static uint32_t         sweep_base_r1;      // R1/R4 as they were at start
+static uint32_t         sweep_base_r4;
+static sweep_player_t   sweep_player;
+
+static volatile bool     sweep_running;
+static volatile uint32_t sweep_left;        // Ticks still to wait before the next step
+static volatile uint32_t sweep_current_khz;
+static bool             sweep_lock_wait;    // Polling LD after the last step
+static uint16_t         sweep_lock_start;   // TCNT1 at that step
+
+// Handshake: main loop fills the stage while sweep_stage_ready is false,
+// the ISR consumes it and clears the flag
+static volatile bool    sweep_stage_ready;
+static ADF4351_FreqWords_t sweep_stage;
+static uint32_t         sweep_stage_khz;
+static uint8_t          sweep_stage_flags;
+
+volatile uint16_t Sweep_Overruns;
+volatile uint16_t Sweep_LockTimeouts;
+
+static uint32_t sweep_freq_at(uint16_t pos)
+{
+    if (sweep_cfg.source == SWEEP_SRC_LIST) return sweep_cfg.list_khz[pos];
+    return sweep_cfg.start_khz + (uint32_t)pos * sweep_cfg.step_khz;
+}
+
+static uint8_t sweep_flags_at(uint16_t pos)
+{
+    uint8_t flags = 0;
+
+    switch (sweep_cfg.mode) {
+    case SWEEP_UP:
+        if (pos == 0) flags |= SWEEP_STAGE_SYNC;
+        if (pos == sweep_count - 1) flags |= SWEEP_STAGE_LAST;
+        break;
+    case SWEEP_DOWN:
+        if (pos == sweep_count - 1) flags |= SWEEP_STAGE_SYNC;
+        if (pos == 0) flags |= SWEEP_STAGE_LAST;
+        break;
+    case SWEEP_TRIANGLE:
+        // Back at the bottom: either the end of a single pass or a new pass
+        if (pos == 0) flags |= (sweep_dir < 0 && sweep_cfg.once) ? SWEEP_STAGE_LAST : SWEEP_STAGE_SYNC;
+        break;
+    }
+    if (!sweep_cfg.once) flags &= ~SWEEP_STAGE_LAST;
+    return flags;
+}
+
+static void sweep_advance(void)
+{
+    switch (sweep_cfg.mode) {
+    case SWEEP_UP:
+        sweep_pos = (sweep_pos + 1 < sweep_count) ? sweep_pos + 1 : 0;
+        break;
+    case SWEEP_DOWN:
+        sweep_pos = (sweep_pos > 0) ? sweep_pos - 1 : sweep_count - 1;
+        break;
+    case SWEEP_TRIANGLE:
+        if (sweep_dir > 0 && sweep_pos + 1 >= sweep_count) sweep_dir = -1;
+        else if (sweep_dir < 0 && sweep_pos == 0) sweep_dir = 1;
+        sweep_pos += sweep_dir;
+        break;
+    }
+}
+
+// Solve the point at sweep_pos into the stage (main loop context); a
+// point the solver refuses is left unstaged, so the next pass moves on
+static void sweep_stage_point(void)
+{
+    uint32_t khz = sweep_freq_at(sweep_pos);
+
+    sweep_stage.r1 = sweep_base_r1;
+    sweep_stage.r4 = sweep_base_r4;
+    if (ADF4351_CalcFrequencyWords(khz, sweep_cfg.refin_hz, sweep_cfg.spacing_hz, 0, &sweep_stage, 0)
+        != ADF4351_Err_None) return;
+    sweep_stage_khz = khz;
+    sweep_stage_flags = sweep_flags_at(sweep_pos);
+    sweep_stage_ready = true;
+}
+
+static void sweep_schedule(void)
+{
+    uint16_t chunk = (sweep_left > 0xFFFFUL) ? SWEEP_MAX_CHUNK : (uint16_t)sweep_left;
+
+    sweep_left -= chunk;
+    OCR1A += chunk;
+}
+
+/** \brief Start a sweep; any running sweep is stopped first */
+bool Sweep_Start(const sweep_config_t *config)
+{
+    Sweep_Stop();
+
+    sweep_cfg = *config;
+    if (sweep_cfg.dwell_us < SWEEP_MIN_DWELL_US) sweep_cfg.dwell_us = SWEEP_MIN_DWELL_US;
+    sweep_dwell_ticks = (uint32_t)(((uint64_t)sweep_cfg.dwell_us * SWEEP_TIMER_HZ) / 1000000UL);
+
+    switch (sweep_cfg.source) {
+    case SWEEP_SRC_LINEAR:
+    {
+        uint32_t count;
+        if (sweep_cfg.step_khz == 0 || sweep_cfg.stop_khz < sweep_cfg.start_khz) return false;
+        if (sweep_cfg.start_khz < ADF4351_RFOUTMIN || sweep_cfg.stop_khz > ADF4351_RFOUT_MAX) return false;
+        count = (sweep_cfg.stop_khz - sweep_cfg.start_khz) / sweep_cfg.step_khz + 1;
+        sweep_count = (count > 0xFFFFUL) ? 0xFFFFU : (uint16_t)count;
+        break;
+    }
+    case SWEEP_SRC_LIST:
+    {
+        uint16_t i;
+        if (sweep_cfg.list_len == 0) return false;
+        for (i = 0; i < sweep_cfg.list_len; i++) {
+            uint32_t khz = sweep_cfg.list_khz[i];
+            if (khz < ADF4351_RFOUTMIN || khz > ADF4351_RFOUT_MAX) return false;
+        }
+        sweep_count = sweep_cfg.list_len;
+        break;
+    }
+    case SWEEP_SRC_TABLE:
+        if (sweep_cfg.table == 0 || sweep_cfg.table->steps == 0) return false;
+        sweep_count = sweep_cfg.table->steps;
+        sweep_cfg.mode = SWEEP_UP;
+        SweepTable_Start(&sweep_player, sweep_cfg.table);
+        break;
+    }
+    if (sweep_cfg.mode == SWEEP_TRIANGLE && sweep_count < 2) sweep_cfg.mode = SWEEP_UP;
+    if (!ADF4351_HasLockDetect()) sweep_cfg.on_lock = false;
+
+    sweep_pos = (sweep_cfg.mode == SWEEP_DOWN) ? sweep_count - 1 : 0;
+    sweep_dir = 1;
+    sweep_base_r1 = ADF4351_Reg1.w;
+    sweep_base_r4 = ADF4351_Reg4.w;
+    Sweep_Overruns = 0;
+    Sweep_LockTimeouts = 0;
+    sweep_lock_wait = false;
+
+    SWEEP_SYNC_DDR |= (1 << SWEEP_SYNC_PIN);
+    SWEEP_SYNC_PORT &= ~(1 << SWEEP_SYNC_PIN);
+
+    sweep_stage_ready = false;
+    if (sweep_cfg.source != SWEEP_SRC_TABLE) {
+        sweep_stage_point();
+        sweep_current_khz = sweep_stage_khz;
+    } else {
+        sweep_current_khz = sweep_cfg.table->start_khz;
+    }
+
+    // First step a few ticks from now, then every dwell
+    cli();
+    sweep_left = 0;
+    OCR1A = TCNT1 + 64;
+    TIFR = (1 << OCF1A);
+    TIMSK |= (1 << OCIE1A);
+    sweep_running = true;
+    sei();
+    return true;
+}
+
+void Sweep_Stop(void)
+{
+    cli();
+    TIMSK &= ~(1 << OCIE1A);
+    sweep_running = false;
+    SWEEP_SYNC_PORT &= ~(1 << SWEEP_SYNC_PIN);
+    sei();
+}
+
+bool Sweep_Running(void)
+{
+    return sweep_running;
+}
+
+/** \brief True while a running SWEEP_SRC_LIST sweep reads config->list_khz */
+bool Sweep_ListRunning(void)
+{
+    return sweep_running && sweep_cfg.source == SWEEP_SRC_LIST;
+}
+
+/** \brief Call from the main loop: solves the next point while the ISR waits */
+void Sweep_Service(void)
+{
+    if (!sweep_running || sweep_stage_ready || sweep_cfg.source == SWEEP_SRC_TABLE) return;
+    sweep_advance();
+    sweep_stage_point();
+}
+
+/** \brief Frequency of the step currently on the output */
+uint32_t Sweep_CurrentKHz(void)
+{
+    uint32_t khz;
+
+    cli();
+    khz = sweep_current_khz;
+    sei();
+    return khz;
+}
+
+// Timer1 Compare A: one sweep step per dwell
+ISR(TIMER1_COMPA_vect)
+{
+    uint8_t flags;
+
+    if (sweep_left) { sweep_schedule(); return; }
+
+    // On-lock mode: poll LD, then wait out the dwell from the lock instant
+    if (sweep_lock_wait) {
+        if (!ADF4351_Locked()) {
+            if ((uint16_t)(TCNT1 - sweep_lock_start) < SWEEP_US_TO_TICKS(SWEEP_LOCK_TIMEOUT_US)) {
+                OCR1A += SWEEP_US_TO_TICKS(SWEEP_LOCK_POLL_US);
+                return;
+            }
+            Sweep_LockTimeouts++;
+        }
+        sweep_lock_wait = false;
+        sweep_left = sweep_dwell_ticks;
+        sweep_schedule();
+        return;
+    }
+
+    if (!sweep_cfg.on_lock) {
+        sweep_left = sweep_dwell_ticks;
+        sweep_schedule();
+    }
+
+    if (sweep_cfg.source == SWEEP_SRC_TABLE) {
+        uint16_t index = sweep_player.index;
+        flags = (index == 0) ? SWEEP_STAGE_SYNC : 0;
+        if (sweep_cfg.once && index == sweep_count - 1) flags |= SWEEP_STAGE_LAST;
+        SweepTable_Next(&sweep_player);
+        sweep_current_khz = sweep_cfg.table->start_khz + (uint32_t)index * sweep_cfg.table->step_khz;
+    } else {
+        if (!sweep_stage_ready) {
+            Sweep_Overruns++;
+            if (sweep_cfg.on_lock) OCR1A += SWEEP_US_TO_TICKS(SWEEP_LOCK_POLL_US);
+            return;
+        }
+        ADF4351_Reg0.w = sweep_stage.r0;
+        ADF4351_Reg1.w = sweep_stage.r1;
+        ADF4351_Reg4.w = sweep_stage.r4;
+        ADF4351_CommitRegisters();
+        sweep_current_khz = sweep_stage_khz;
+        flags = sweep_stage_flags;
+        sweep_stage_ready = false;
+    }
+
+    if (flags & SWEEP_STAGE_SYNC) SWEEP_SYNC_PORT |= (1 << SWEEP_SYNC_PIN);
+    else                          SWEEP_SYNC_PORT &= ~(1 << SWEEP_SYNC_PIN);
+
+    if (flags & SWEEP_STAGE_LAST) {
+        TIMSK &= ~(1 << OCIE1A);
+        sweep_running = false;
+    }
+    // Main loop: stage the next point, follow the display
+    EVENT_POST(EVENT_SWEEP);
+
+    // First LD poll counts from the last latch; the words take longer than a poll
+    if (sweep_cfg.on_lock) {
+        sweep_lock_wait = true;
+        sweep_lock_start = TCNT1;
+        OCR1A = sweep_lock_start + SWEEP_US_TO_TICKS(SWEEP_LOCK_POLL_US);
+    }
+}
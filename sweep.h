@@ -0,0 +1,83 @@
+/**
+ * @file     sweep.h
+ * @brief    Timer1 driven frequency sweep engine
+ * @date     16 October 2026
+ *
+ * Steps are committed from ISR(TIMER1_COMPA_vect), so register writes land
+ * at fixed instants no matter what the main loop is doing. For linear and
+ * list sweeps the main loop solves the next point ahead of time in
+ * Sweep_Service(); the ISR only loads and shifts out the staged words.
+ * Table sweeps (sweep_table.h) need no staging at all.
+ *
+ * Timer1 must be running free at SWEEP_TIMER_HZ (normal mode, clk/8); the
+ * engine only uses OCR1A. While a sweep runs the ISR owns the ADF4351
+ * shadows, so nothing else may commit registers until Sweep_Stop().
+ *
+ * With on_lock set and a lock-detect pin on the transport, the dwell is
+ * counted from lock instead of from the write: the ISR polls LD every
+ * SWEEP_LOCK_POLL_US after a step and starts the dwell once it is high
+ * (or after SWEEP_LOCK_TIMEOUT_US, counted in Sweep_LockTimeouts).
+ */
+
+#ifndef SWEEP_H_
+#define SWEEP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sweep_table.h"
+
+#define SWEEP_TIMER_HZ          (F_CPU / 8)
+
+// Shortest dwell accepted: three words over the fast SPI path plus ISR
+// entry. Linear/list sweeps also need the solver to finish within one
+// dwell, otherwise a step is held and Sweep_Overruns counts it.
+#define SWEEP_MIN_DWELL_US      100UL
+
+// Lock-advance polling; the dwell then only has to cover the measurement
+#define SWEEP_LOCK_POLL_US      20UL
+#define SWEEP_LOCK_TIMEOUT_US   2000UL
+
+// Sync output, high for the first step of every pass
+#define SWEEP_SYNC_DDR          DDRB
+#define SWEEP_SYNC_PORT         PORTB
+#define SWEEP_SYNC_PIN          PB3
+
+typedef enum {
+    SWEEP_SRC_LINEAR,           // start_khz..stop_khz in step_khz increments
+    SWEEP_SRC_LIST,             // list_khz[0..list_len-1], kept in RAM
+    SWEEP_SRC_TABLE             // Precomputed flash table, forward only
+} sweep_source_t;
+
+typedef enum {
+    SWEEP_UP,
+    SWEEP_DOWN,
+    SWEEP_TRIANGLE
+} sweep_mode_t;
+
+typedef struct {
+    sweep_source_t       source;
+    sweep_mode_t         mode;
+    bool                 once;          // Stop after one pass instead of repeating
+    bool                 on_lock;       // Dwell starts at lock instead of at the write
+    uint32_t             dwell_us;
+    uint32_t             refin_hz;      // Solver setup for linear/list sources
+    uint32_t             spacing_hz;
+    uint32_t             start_khz;
+    uint32_t             stop_khz;
+    uint32_t             step_khz;
+    const uint32_t      *list_khz;
+    uint16_t             list_len;
+    const sweep_table_t *table;
+} sweep_config_t;
+
+extern volatile uint16_t Sweep_Overruns;
+extern volatile uint16_t Sweep_LockTimeouts;
+
+bool     Sweep_Start(const sweep_config_t *config);
+void     Sweep_Stop(void);
+bool     Sweep_Running(void);
+bool     Sweep_ListRunning(void);
+void     Sweep_Service(void);
+uint32_t Sweep_CurrentKHz(void);
+
+#endif /* SWEEP_H_ */
@@ -0,0 +1,47 @@
+/**
+ * @file     sweep_table.c
+ * @brief    Replay of precomputed ADF4351 register tables stored in flash
+ * @date     16 October 2026
+ */
+
+#include <avr/pgmspace.h>
+#include "sweep_table.h"
+#include "adf4351.h"
+
+/** \brief Rewind a player to step 0 of a table */
+void SweepTable_Start(sweep_player_t *player, const sweep_table_t *table)
+{
+    player->table = table;
+    player->pos = table->data;
+    player->index = 0;
+}
+
+/** \brief Load the next step into the shadows and commit it
+ *
+ *  No solver math: the words come straight from flash. Of a table R4
+ *  word only the output divider is used; the output enable, power and
+ *  the band select clock divider the firmware set up for the live PFD
+ *  stay as they are (same as the hop table). Wraps to step 0 after the
+ *  last step. Returns the number of words sent.
+ */
+uint8_t SweepTable_Next(sweep_player_t *player)
+{
+    const uint8_t *p = player->pos;
+    uint8_t mask = pgm_read_byte(p++);
+
+    if (mask & SWEEP_TABLE_R4) {
+        ADF4351_Reg4_t r4;
+        r4.w = pgm_read_dword(p); p += 4;
+        ADF4351_Reg4.b.RfDivSel = r4.b.RfDivSel;
+    }
+    if (mask & SWEEP_TABLE_R1) { ADF4351_Reg1.w = pgm_read_dword(p); p += 4; }
+    if (mask & SWEEP_TABLE_R0) { ADF4351_Reg0.w = pgm_read_dword(p); p += 4; }
+
+    if (++player->index >= player->table->steps) {
+        player->index = 0;
+        p = player->table->data;
+    }
+    player->pos = p;
+
+    return ADF4351_CommitRegisters();
+}
@@ -0,0 +1,44 @@
+/**
+ * @file     sweep_table.h
+ * @brief    Replay of precomputed ADF4351 register tables stored in flash
+ * @date     16 October 2026
+ *
+ * Tables are produced offline by host/sweepgen.c from a frequency plan and
+ * compiled into the firmware as PROGMEM data. Each step is one mask byte
+ * (bit n set: Rn follows, same numbering as ADF4351_DirtyMask) followed by
+ * the changed R0/R1/R4 words, little-endian. The first step always carries
+ * all three words, so playback can restart from it at any time. Only the
+ * output divider of an R4 word is played back; the rest of R4 (output
+ * enable, power, band select clock) belongs to the running firmware.
+ *
+ * No table is compiled into this firmware yet: SWEEP_SRC_TABLE is there
+ * for a build that adds a generated file and starts it through
+ * Sweep_Start().
+ */
+
+#ifndef SWEEP_TABLE_H_
+#define SWEEP_TABLE_H_
+
+#include <stdint.h>
+
+#define SWEEP_TABLE_R0      (1 << 0)
+#define SWEEP_TABLE_R1      (1 << 1)
+#define SWEEP_TABLE_R4      (1 << 4)
+
+typedef struct {
+    const uint8_t *data;        // PROGMEM step stream
+    uint16_t       steps;
+    uint32_t       start_khz;   // Linear plans: frequency of step 0
+    uint32_t       step_khz;    // Linear plans: increment, 0 for list plans
+} sweep_table_t;
+
+typedef struct {
+    const sweep_table_t *table;
+    const uint8_t       *pos;
+    uint16_t             index;  // Step the next call will load
+} sweep_player_t;
+
+void    SweepTable_Start(sweep_player_t *player, const sweep_table_t *table);
+uint8_t SweepTable_Next(sweep_player_t *player);
+
+#endif /* SWEEP_TABLE_H_ */
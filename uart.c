@@ -0,0 +1,91 @@
+/**
+ * @file     uart.c
+ * @brief    Interrupt driven USART with RX/TX ring buffers
+ * @date     16 October 2026
+ */
+
+#ifndef F_CPU
+#define F_CPU 11059200UL
+#endif
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
+#include "uart.h"
+#include "event.h"
+
+#define UART_UBRR           ((F_CPU / (16UL * UART_BAUD)) - 1)
+
+static volatile uint8_t uart_rx[UART_RX_SIZE];
+static volatile uint8_t uart_rx_head, uart_rx_tail;
+static volatile uint8_t uart_tx[UART_TX_SIZE];
+static volatile uint8_t uart_tx_head, uart_tx_tail;
+
+volatile uint16_t UART_RxDropped;
+
+void UART_Init(void)
+{
+    UBRRH = (uint8_t)(UART_UBRR >> 8);
+    UBRRL = (uint8_t)UART_UBRR;
+    UCSRA = 0;
+    UCSRC = (1 << URSEL) | (1 << UCSZ1) | (1 << UCSZ0);   // 8N1
+    UCSRB = (1 << RXCIE) | (1 << RXEN) | (1 << TXEN);
+}
+
+bool UART_Available(void)
+{
+    return uart_rx_head != uart_rx_tail;
+}
+
+int16_t UART_Read(void)
+{
+    uint8_t data;
+
+    if (uart_rx_head == uart_rx_tail) return -1;
+    data = uart_rx[uart_rx_tail];
+    uart_rx_tail = (uart_rx_tail + 1) & (UART_RX_SIZE - 1);
+    return data;
+}
+
+void UART_Write(uint8_t data)
+{
+    uint8_t next = (uart_tx_head + 1) & (UART_TX_SIZE - 1);
+
+    // The ISR frees a slot every byte time; the delay also lets the host
+    // simulation advance its clock while waiting
+    while (next == uart_tx_tail) _delay_us(1);
+    uart_tx[uart_tx_head] = data;
+    uart_tx_head = next;
+    UCSRB |= (1 << UDRIE);
+}
+
+void UART_WriteBuffer(const uint8_t *data, uint8_t len)
+{
+    while (len--) UART_Write(*data++);
+}
+
+// USART Receive Complete: store, or drop when the main loop fell behind
+ISR(USART_RXC_vect)
+{
+    uint8_t data = UDR;
+    uint8_t next = (uart_rx_head + 1) & (UART_RX_SIZE - 1);
+
+    if (next == uart_rx_tail) {
+        UART_RxDropped++;
+        return;
+    }
+    uart_rx[uart_rx_head] = data;
+    uart_rx_head = next;
+    EVENT_POST(EVENT_UART);
+}
+
+// USART Data Register Empty: next queued byte, or stop the interrupt
+ISR(USART_UDRE_vect)
+{
+    if (uart_tx_head == uart_tx_tail) {
+        UCSRB &= ~(1 << UDRIE);
+        return;
+    }
+    UDR = uart_tx[uart_tx_tail];
+    uart_tx_tail = (uart_tx_tail + 1) & (UART_TX_SIZE - 1);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file     uart.h
+ * @brief    Interrupt driven USART with RX/TX ring buffers
+ * @date     16 October 2026
+ *
+ * RX bytes are stored by ISR(USART_RXC_vect) and read from the main loop;
+ * TX bytes are queued by the main loop and sent by ISR(USART_UDRE_vect).
+ * Sizes must be powers of two. Bytes arriving while the RX ring is full
+ * are dropped and counted in UART_RxDropped.
+ */
+
+#ifndef UART_H_
+#define UART_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UART_BAUD           115200UL    // Exact at F_CPU 11.0592 MHz
+#ifdef PROFILE_ENABLE                   // Room for the statistics (profile.h)
+#define UART_RX_SIZE        32
+#define UART_TX_SIZE        8
+#else
+#define UART_RX_SIZE        64          // ~5.5 ms of input while a reply waits for TX room
+#define UART_TX_SIZE        32
+#endif
+
+extern volatile uint16_t UART_RxDropped;
+
+void     UART_Init(void);
+bool     UART_Available(void);
+int16_t  UART_Read(void);               // -1 when empty
+void     UART_Write(uint8_t data);      // Waits while the TX ring is full
+void     UART_WriteBuffer(const uint8_t *data, uint8_t len);
+
+#endif /* UART_H_ */